@@ -45,23 +45,18 @@ const ::inflection::dictionary::Inflector& DictionaryExposableMorphology::getInf
     if (dictionary.getCombinedBinaryType(&wordGrammemes, word) == nullptr) {
         return {};
     }
-    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> inflectionPatterns;
-    inflector.getInflectionPatternsForWord(word, inflectionPatterns);
-    if (inflectionPatterns.empty()) {
-        return {wordGrammemes};
-    }
-
     ::std::vector<int64_t> wordGrammemesets;
-    for (const auto& inflectionPattern : inflectionPatterns) {
+    inflector.visitInflectionPatternsForWord(word, [&](const ::inflection::dictionary::Inflector_InflectionPattern& inflectionPattern) {
         auto pos = inflectionPattern.getPartsOfSpeech();
         if (inflectionPattern.numInflections() == 0) {
             wordGrammemesets.push_back(pos);
-            continue;
+            return true;
         }
         for (const auto& inflection : inflectionPattern.inflectionsForSurfaceForm(word, wordGrammemes)) {
             wordGrammemesets.push_back(inflection.getGrammemes() | pos);
         }
-    }
+        return true;
+    });
     if (wordGrammemesets.empty()) {
         return {wordGrammemes};
     }
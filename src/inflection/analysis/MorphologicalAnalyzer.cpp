@@ -64,7 +64,7 @@ int8_t MorphologicalAnalyzer::compareGrammemes(int64_t grammemes1, int64_t gramm
     return 0;
 }
 
-static bool isImportant(const int64_t grammemes, const ::std::vector<int64_t>& ignoreGrammemeSets) {
+bool MorphologicalAnalyzer::isImportant(int64_t grammemes) const {
     const auto containsGrammemeSet = [grammemes](const int64_t grammemeSet){ return (grammemes & grammemeSet) == grammemeSet;};
     return std::ranges::none_of(ignoreGrammemeSets, containsGrammemeSet);
 }
@@ -75,20 +75,18 @@ void MorphologicalAnalyzer::filterInflectionGrammemes(::std::u16string_view word
                                                       ::std::vector<InflectionGrammemes> &inflectionGrammemes) const
 {
     for (const auto& inflectionPattern : inflectionPatterns) {
-        auto pos = inflectionPattern.getPartsOfSpeech();
-        if (inflectionPattern.numInflections() == 0) {
-            if (isImportant(pos, ignoreGrammemeSets)) {
-                inflectionGrammemes.emplace_back(pos, std::nullopt);
-            }
-            continue;
-        }
-        for (const auto& inflection : inflectionPattern.inflectionsForSurfaceForm(word, wordGrammemes)) {
-            auto currGrammemes =  inflection.getGrammemes() | pos;
-            if (isImportant(currGrammemes, ignoreGrammemeSets)) {
-                inflectionGrammemes.emplace_back(currGrammemes, inflection);
-            }
-        }
+        filterInflectionGrammemes(word, wordGrammemes, inflectionPattern, inflectionGrammemes);
     }
 }
 
+void MorphologicalAnalyzer::filterInflectionGrammemes(::std::u16string_view word,
+                                                      int64_t wordGrammemes,
+                                                      const ::inflection::dictionary::Inflector_InflectionPattern& inflectionPattern,
+                                                      ::std::vector<InflectionGrammemes> &inflectionGrammemes) const
+{
+    visitInflectionGrammemes(word, wordGrammemes, inflectionPattern, [&inflectionGrammemes](int64_t grammemes, const ::std::optional<Inflector_Inflection>& inflection) {
+        inflectionGrammemes.emplace_back(grammemes, inflection);
+    });
+}
+
 } //namespace inflection::analysis
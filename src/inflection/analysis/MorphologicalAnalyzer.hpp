@@ -19,10 +19,42 @@ protected:
 
 public:
     int8_t compareGrammemes(int64_t grammemes1, int64_t grammemes2) const;
+    /**
+     * Append the inflections of the patterns that match the word. The appended inflections point at the patterns, so
+     * the patterns must not be moved or destroyed while they are used.
+     */
     void filterInflectionGrammemes(::std::u16string_view word, int64_t wordGrammemes, const ::std::vector<::inflection::dictionary::Inflector_InflectionPattern>& inflectionPatterns, ::std::vector<InflectionGrammemes> &inflectionGrammemes) const;
+    void filterInflectionGrammemes(::std::u16string_view word, int64_t wordGrammemes, const ::inflection::dictionary::Inflector_InflectionPattern& inflectionPattern, ::std::vector<InflectionGrammemes> &inflectionGrammemes) const;
+    /**
+     * Like filterInflectionGrammemes, but visitor(grammemes, inflection) is called for each inflection instead of
+     * appending it, so the caller decides where the inflections are kept.
+     */
+    template <typename Visitor>
+    void visitInflectionGrammemes(::std::u16string_view word, int64_t wordGrammemes, const ::inflection::dictionary::Inflector_InflectionPattern& inflectionPattern, Visitor&& visitor) const;
 
     MorphologicalAnalyzer(const ::inflection::util::ULocale& locale, const ::std::vector<::std::u16string_view> &lemmaAttributes, const std::vector<::std::vector<std::u16string_view>> &grammemePriorityStringTables = {}, const ::std::vector<::std::vector<::std::u16string>> &ignoreGrammemeSets = {});
     ~MorphologicalAnalyzer() override;
 
     static std::vector<int64_t> convertLemmaAttributes(const dictionary::DictionaryMetaData &dictionary, const std::vector<::std::u16string_view> &lemmaAttributes);
+
+private:
+    bool isImportant(int64_t grammemes) const;
 };
+
+template <typename Visitor>
+void inflection::analysis::MorphologicalAnalyzer::visitInflectionGrammemes(::std::u16string_view word, int64_t wordGrammemes, const ::inflection::dictionary::Inflector_InflectionPattern& inflectionPattern, Visitor&& visitor) const
+{
+    auto pos = inflectionPattern.getPartsOfSpeech();
+    if (inflectionPattern.numInflections() == 0) {
+        if (isImportant(pos)) {
+            visitor(pos, ::std::optional<::inflection::dictionary::Inflector_Inflection>());
+        }
+        return;
+    }
+    for (const auto& inflection : inflectionPattern.inflectionsForSurfaceForm(word, wordGrammemes)) {
+        auto currGrammemes = inflection.getGrammemes() | pos;
+        if (isImportant(currGrammemes)) {
+            visitor(currGrammemes, ::std::optional<::inflection::dictionary::Inflector_Inflection>(inflection));
+        }
+    }
+}
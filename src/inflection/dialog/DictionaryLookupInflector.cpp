@@ -3,18 +3,23 @@
  */
 #include <inflection/dialog/DictionaryLookupInflector.hpp>
 #include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/exception/IllegalArgumentException.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/StringUtils.hpp>
 #include <inflection/util/LoggerConfig.hpp>
 #include <inflection/util/Logger.hpp>
+#include <inflection/npc.hpp>
 #include <algorithm>
+#include <array>
 #include <bit>
+#include <list>
+#include <span>
 #include <string>
+#include <vector>
 #include <unicode/uchar.h>
 
 namespace inflection::dialog {
 
-using ::inflection::util::LoggerConfig;
 using ::inflection::util::Logger;
 
 DictionaryLookupInflector::DictionaryLookupInflector(const ::inflection::util::ULocale &locale, const std::vector<::std::vector<std::u16string_view>> &propertyPrioritiesData, const ::std::vector<::std::vector<::std::u16string>> &ignoreGrammemeSets, bool enableDictionaryFallback)
@@ -27,6 +32,74 @@ DictionaryLookupInflector::~DictionaryLookupInflector()
 {
 }
 
+/**
+ * The inflection candidates of every case variant of a word, in one list. Most words have 1-3 inflection patterns and
+ * a few candidates, so those are kept inline, and an inflect call does not allocate a container for them.
+ */
+struct DictionaryLookupInflector::InflectionCandidates final
+{
+    struct Candidate {
+        ::inflection::analysis::DictionaryExposableMorphology::InflectionGrammemes inflectionGrammemes { 0, ::std::nullopt };
+        int32_t variant { 0 };
+        /**
+         * The order that the candidate was found in. Sorting by it last keeps equal candidates in the dictionary order.
+         */
+        int32_t order { 0 };
+    };
+
+    /**
+     * The candidates point at their pattern, so a pattern is never moved once it is added.
+     */
+    const ::inflection::dictionary::Inflector_InflectionPattern& addPattern(const ::inflection::dictionary::Inflector_InflectionPattern& inflectionPattern);
+    void addCandidate(int64_t grammemes, const ::std::optional<::inflection::dictionary::Inflector_Inflection>& inflection, int32_t variant);
+    ::std::span<Candidate> getCandidates();
+
+private:
+    static constexpr int32_t INLINE_PATTERNS = 4;
+    static constexpr int32_t INLINE_CANDIDATES = 16;
+
+    ::std::array<::std::optional<::inflection::dictionary::Inflector_InflectionPattern>, INLINE_PATTERNS> inlinePatterns {  };
+    int32_t inlinePatternsSize { 0 };
+    ::std::list<::inflection::dictionary::Inflector_InflectionPattern> overflowPatterns {  };
+    ::std::array<Candidate, INLINE_CANDIDATES> inlineCandidates {  };
+    ::std::vector<Candidate> overflowCandidates {  };
+    int32_t candidatesSize { 0 };
+};
+
+const ::inflection::dictionary::Inflector_InflectionPattern& DictionaryLookupInflector::InflectionCandidates::addPattern(const ::inflection::dictionary::Inflector_InflectionPattern& inflectionPattern)
+{
+    if (inlinePatternsSize < INLINE_PATTERNS) {
+        return inlinePatterns[inlinePatternsSize++].emplace(inflectionPattern);
+    }
+    return overflowPatterns.emplace_back(inflectionPattern);
+}
+
+void DictionaryLookupInflector::InflectionCandidates::addCandidate(int64_t grammemes, const ::std::optional<::inflection::dictionary::Inflector_Inflection>& inflection, int32_t variant)
+{
+    Candidate candidate;
+    candidate.inflectionGrammemes.grammemes = grammemes;
+    candidate.inflectionGrammemes.inflection = inflection;
+    candidate.variant = variant;
+    candidate.order = candidatesSize;
+    if (candidatesSize < INLINE_CANDIDATES) {
+        inlineCandidates[candidatesSize] = candidate;
+    } else {
+        if (candidatesSize == INLINE_CANDIDATES) {
+            overflowCandidates.assign(inlineCandidates.begin(), inlineCandidates.end());
+        }
+        overflowCandidates.push_back(candidate);
+    }
+    candidatesSize++;
+}
+
+::std::span<DictionaryLookupInflector::InflectionCandidates::Candidate> DictionaryLookupInflector::InflectionCandidates::getCandidates()
+{
+    if (candidatesSize > INLINE_CANDIDATES) {
+        return overflowCandidates;
+    }
+    return ::std::span<Candidate>(inlineCandidates.data(), candidatesSize);
+}
+
 namespace {
 
 static void traceLogInflectCall(const std::u16string &funcName, std::u16string_view word, const std::vector<::std::u16string> &constraints, const std::vector<std::u16string> &optionalConstraints, const std::vector<::std::u16string> &disambiguationGrammemeValues) {
@@ -36,69 +109,96 @@ static void traceLogInflectCall(const std::u16string &funcName, std::u16string_v
         + u"disambiguationGrammemeValues = [" + inflection::util::StringViewUtils::join(disambiguationGrammemeValues, u", ") + u"])\n");
 }
 
-static void traceLogSortedInflectionGrammemes(const ::std::vector<::inflection::analysis::DictionaryExposableMorphology::InflectionGrammemes> &inflectionGrammemes, const dictionary::DictionaryMetaData& dictionary) {
+template <typename Candidate>
+static void traceLogSortedInflectionGrammemes(::std::span<const Candidate> candidates, ::std::span<const ::std::u16string_view> variants, const dictionary::DictionaryMetaData& dictionary) {
     std::u16string logStream(u"Sorted Inflection Grammemes:\n");
-    for (const auto& inflectionCandidate: inflectionGrammemes) {
-        logStream.append(u"\t\t").append(inflectionCandidate.getDescription(dictionary)).append(u"\n");
+    for (const auto& candidate : candidates) {
+        logStream.append(u"\t\t").append(variants[candidate.variant]).append(u": ").append(candidate.inflectionGrammemes.getDescription(dictionary)).append(u"\n");
     }
     Logger::trace(logStream);
 }
 
+static void requireKnownProperties(const ::std::vector<int64_t> &grammemes) {
+    if (::std::ranges::find(grammemes, 0) != grammemes.end()) {
+        throw ::inflection::exception::IllegalArgumentException(u"Properties are not recognized");
+    }
 }
 
-::std::optional<::std::u16string> DictionaryLookupInflector::inflectWordImplementation(std::u16string_view word, int64_t wordGrammemes, const std::vector<::std::u16string> &constraints, const std::vector<std::u16string> &optionalConstraints, const std::vector<::std::u16string> &disambiguationGrammemeValues) const {
-    if (LoggerConfig::isTraceEnabled()) {
-        traceLogInflectCall(u"DictionaryLookupInflector::inflectWord", word, constraints, optionalConstraints, disambiguationGrammemeValues);
-    }
+}
 
-    // Word not in dictionary
-    if (wordGrammemes == 0) {
-        if (LoggerConfig::isTraceEnabled()) {
-            Logger::trace(std::u16string(word) + u": not in dictionary return std::nullopt\n");
-        }
-        return {};
+DictionaryLookupInflector::ConstraintGrammemes DictionaryLookupInflector::resolveConstraintGrammemes(const std::vector<::std::u16string> &constraints, const std::vector<std::u16string> &optionalConstraints, const std::vector<::std::u16string> &disambiguationGrammemeValues) const {
+    const auto &dictionary = getDictionary();
+    ConstraintGrammemes result;
+    int64_t constraintsGrammemes = 0;
+    // Unknown constraints are only reported when an inflection uses them.
+    if (constraints.empty() || dictionary.getBinaryProperties(&constraintsGrammemes, constraints) != nullptr) {
+        result.constraints = constraintsGrammemes;
     }
+    dictionary.getBinaryPropertiesOfEach(&result.optionalConstraints, optionalConstraints);
+    dictionary.getBinaryPropertiesOfEach(&result.disambiguationGrammemes, disambiguationGrammemeValues);
+    return result;
+}
 
-    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> inflectionPatterns;
-    getInflector().getInflectionPatternsForWord(word, inflectionPatterns);
-    if (inflectionPatterns.empty()) {
-        if (LoggerConfig::isTraceEnabled()) {
-            Logger::trace(u"\t" + std::u16string(word) + u": no inflection patterns found\n");
-        }
-        return {};
+void DictionaryLookupInflector::collectInflectionCandidates(InflectionCandidates* candidates, std::u16string_view word, int32_t variant, int64_t wordGrammemes, bool traceEnabled) const {
+    bool hasInflectionPattern = false;
+    getInflector().visitInflectionPatternsForWord(word, [&](const ::inflection::dictionary::Inflector_InflectionPattern& visitedPattern) {
+        hasInflectionPattern = true;
+        // The visited pattern only lives during the visit, and the candidates point at their pattern.
+        const auto& inflectionPattern = npc(candidates)->addPattern(visitedPattern);
+        visitInflectionGrammemes(word, wordGrammemes, inflectionPattern, [candidates, variant](int64_t grammemes, const ::std::optional<::inflection::dictionary::Inflector_Inflection>& inflection) {
+            candidates->addCandidate(grammemes, inflection, variant);
+        });
+        return true;
+    });
+    if (!hasInflectionPattern && traceEnabled) {
+        Logger::trace(u"\t" + std::u16string(word) + u": no inflection patterns found\n");
     }
-    ::std::vector<::inflection::analysis::DictionaryExposableMorphology::InflectionGrammemes> inflectionGrammemes;
-    filterInflectionGrammemes(word, wordGrammemes, inflectionPatterns, inflectionGrammemes);
+}
 
+::std::optional<::std::u16string> DictionaryLookupInflector::inflectInflectionCandidates(InflectionCandidates* candidates, ::std::span<const ::std::u16string_view> variants, int32_t* inflectedVariant, const std::vector<::std::u16string> &constraints, const std::vector<std::u16string> &optionalConstraints, const ConstraintGrammemes &constraintGrammemes, bool traceEnabled) const {
+    auto sortedCandidates = npc(candidates)->getCandidates();
     // No inflection patterns found
-    if (inflectionGrammemes.empty()) {
+    if (sortedCandidates.empty()) {
         return {};
     }
 
     const auto &dictionary = getDictionary();
-    ::std::vector<int64_t> disambiguationGrammemes;
-    disambiguationGrammemes.reserve(disambiguationGrammemeValues.size());
-    for (const auto &disambiguationGrammemeValue : disambiguationGrammemeValues) {
-        disambiguationGrammemes.push_back(dictionary.getBinaryProperties({disambiguationGrammemeValue}));
-    }
+    const auto &disambiguationGrammemes = constraintGrammemes.disambiguationGrammemes;
+    requireKnownProperties(disambiguationGrammemes);
 
-    if (inflectionGrammemes.size() > 1) {
-        const auto inflectionComparator = [&](const InflectionGrammemes& inflection1, const InflectionGrammemes& inflection2) {
-            return DictionaryLookupInflector::compareInflectionGrammemes(inflection1, inflection2, disambiguationGrammemes) < 0;
+    if (sortedCandidates.size() > 1) {
+        // The candidates of a lower variant always come first, so the word as is is preferred over its lowercased form.
+        // The order of the candidates is unique, so this sorts like a stable sort without its temporary buffer.
+        const auto inflectionComparator = [&](const InflectionCandidates::Candidate& candidate1, const InflectionCandidates::Candidate& candidate2) {
+            if (candidate1.variant != candidate2.variant) {
+                return candidate1.variant < candidate2.variant;
+            }
+            const auto comparison = DictionaryLookupInflector::compareInflectionGrammemes(candidate1.inflectionGrammemes, candidate2.inflectionGrammemes, disambiguationGrammemes);
+            if (comparison != 0) {
+                return comparison < 0;
+            }
+            return candidate1.order < candidate2.order;
         };
 
-        std::ranges::stable_sort(inflectionGrammemes, inflectionComparator);
-        if (LoggerConfig::isTraceEnabled()) {
-            traceLogSortedInflectionGrammemes(inflectionGrammemes, dictionary);
+        std::ranges::sort(sortedCandidates, inflectionComparator);
+        if (traceEnabled) {
+            traceLogSortedInflectionGrammemes<InflectionCandidates::Candidate>(sortedCandidates, variants, dictionary);
         }
     }
 
-    for (const auto &inflectionCandidate : inflectionGrammemes) {
-        if (!inflectionCandidate.inflection.has_value()) {
+    // Without the dictionary fallback, only the first candidate of each variant is reinflected.
+    int32_t exhaustedVariant = -1;
+    for (const auto &inflectionCandidate : sortedCandidates) {
+        if (inflectionCandidate.variant == exhaustedVariant) {
+            continue;
+        }
+        const auto word = variants[inflectionCandidate.variant];
+        *npc(inflectedVariant) = inflectionCandidate.variant;
+        if (!inflectionCandidate.inflectionGrammemes.inflection.has_value()) {
             return std::u16string(word);
         }
-        const auto &inflection = inflectionCandidate.inflection.value();
-        if (LoggerConfig::isTraceEnabled()) {
+        const auto &inflection = inflectionCandidate.inflectionGrammemes.inflection.value();
+        if (traceEnabled) {
             Logger::trace(std::u16string(u"reinflect function called:\n\targs:")
                           + u"\n\t\tword:"
                           + std::u16string(word)
@@ -111,50 +211,88 @@ static void traceLogSortedInflectionGrammemes(const ::std::vector<::inflection::
                           + u"\n");
         }
         
-        std::vector<int64_t> optionalConstraintGrammemes;
-        optionalConstraintGrammemes.reserve(optionalConstraints.size());
-        for (const auto &optionalConstraint: optionalConstraints) {
-            optionalConstraintGrammemes.emplace_back(dictionary.getBinaryProperties({optionalConstraint}));
+        requireKnownProperties(constraintGrammemes.optionalConstraints);
+        if (!constraintGrammemes.constraints) {
+            throw ::inflection::exception::IllegalArgumentException(u"Properties are not recognized");
         }
 
-        auto inflectedWord(inflection.getInflectionPattern().reinflectWithOptionalConstraints(inflection.getGrammemes(), dictionary.getBinaryProperties(constraints), optionalConstraintGrammemes, word));
+        auto inflectedWord(inflection.getInflectionPattern().reinflectWithOptionalConstraints(inflection.getGrammemes(), *constraintGrammemes.constraints, constraintGrammemes.optionalConstraints, word));
 
         if (!inflectedWord.empty()) {
             return inflectedWord;
         }
         if (!enableDictionaryFallback) {
-            break;
+            exhaustedVariant = inflectionCandidate.variant;
         }
     }
     return {};
 }
 
+::std::optional<::std::u16string> DictionaryLookupInflector::inflectWordImplementation(std::u16string_view word, int64_t wordGrammemes, const std::vector<::std::u16string> &constraints, const std::vector<std::u16string> &optionalConstraints, const std::vector<::std::u16string> &disambiguationGrammemeValues, const ConstraintGrammemes &constraintGrammemes) const {
+    const bool traceEnabled = INFLECTION_IS_TRACE_ENABLED();
+    if (traceEnabled) {
+        traceLogInflectCall(u"DictionaryLookupInflector::inflectWord", word, constraints, optionalConstraints, disambiguationGrammemeValues);
+    }
+
+    // Word not in dictionary
+    if (wordGrammemes == 0) {
+        if (traceEnabled) {
+            Logger::trace(std::u16string(word) + u": not in dictionary return std::nullopt\n");
+        }
+        return {};
+    }
+
+    InflectionCandidates candidates;
+    collectInflectionCandidates(&candidates, word, 0, wordGrammemes, traceEnabled);
+    int32_t inflectedVariant = 0;
+    return inflectInflectionCandidates(&candidates, ::std::span<const ::std::u16string_view>(&word, 1), &inflectedVariant, constraints, optionalConstraints, constraintGrammemes, traceEnabled);
+}
+
 ::std::optional<::std::u16string> DictionaryLookupInflector::inflect(std::u16string_view word, int64_t wordGrammemes, const std::vector<::std::u16string> &constraints, const std::vector<::std::u16string> &disambiguationGrammemeValues) const {
     return inflectWithOptionalConstraints(word, wordGrammemes, constraints, {}, disambiguationGrammemeValues);
 }
 
 ::std::optional<::std::u16string> DictionaryLookupInflector::inflectWithOptionalConstraints(std::u16string_view word, int64_t wordGrammemes, const std::vector<::std::u16string> &constraints, const std::vector<::std::u16string> &optionalConstraints, const std::vector<::std::u16string> &disambiguationGrammemeValues) const {
-    if (LoggerConfig::isTraceEnabled()) {
+    const bool traceEnabled = INFLECTION_IS_TRACE_ENABLED();
+    if (traceEnabled) {
         traceLogInflectCall(u"DictionaryLookupInflector::inflect", word, constraints, optionalConstraints, disambiguationGrammemeValues);
     }
     // Constraints are empty
     if (std::ranges::all_of(constraints, [](const auto &x){ return x.empty(); })) {
         return std::u16string(word);
     }
-    const bool allCaps = inflection::util::StringViewUtils::isAllUpperCase(word);
-    // Never try to inflect all caps as is, we face issues like:
-    // BIENVENU matching as bienvenu in the dictionary which has the inflection "" -> "e" which when applied to BIENVENU returns "BIENVENUe"
-    if (!allCaps) {
-        auto inflectedWord = inflectWordImplementation(word, wordGrammemes, constraints, optionalConstraints, disambiguationGrammemeValues);
-        if (inflectedWord.has_value()) {
-            return inflectedWord;
+    // Word not in dictionary. The grammemes are shared by every case variant of the word.
+    if (wordGrammemes == 0) {
+        if (traceEnabled) {
+            Logger::trace(std::u16string(word) + u": not in dictionary return std::nullopt\n");
         }
+        return {};
     }
+    const auto constraintGrammemes(resolveConstraintGrammemes(constraints, optionalConstraints, disambiguationGrammemeValues));
+    const bool allCaps = inflection::util::StringViewUtils::isAllUpperCase(word);
     const auto locale = getLocale();
     ::std::u16string lowerCasedWord;
     ::inflection::util::StringViewUtils::lowercase(&lowerCasedWord, word, locale);
-    auto inflectedWord = inflectWordImplementation(lowerCasedWord, wordGrammemes, constraints, optionalConstraints, disambiguationGrammemeValues);
-    if (inflectedWord.has_value()) {
+
+    // Both case variants are looked up up front, and their candidates are sorted and reinflected as one list.
+    // The candidates of the word as is come first, so the result is the same as trying the lowercased word only after
+    // the word as is fails.
+    constexpr int32_t AS_IS_VARIANT = 0;
+    constexpr int32_t LOWERCASED_VARIANT = 1;
+    const ::std::u16string_view variants[] = {word, lowerCasedWord};
+    InflectionCandidates candidates;
+    // Never try to inflect all caps as is, we face issues like:
+    // BIENVENU matching as bienvenu in the dictionary which has the inflection "" -> "e" which when applied to BIENVENU returns "BIENVENUe"
+    if (!allCaps) {
+        collectInflectionCandidates(&candidates, word, AS_IS_VARIANT, wordGrammemes, traceEnabled);
+    }
+    // A word that is already lowercase is only looked up once.
+    if (allCaps || lowerCasedWord != word) {
+        collectInflectionCandidates(&candidates, lowerCasedWord, LOWERCASED_VARIANT, wordGrammemes, traceEnabled);
+    }
+    int32_t inflectedVariant = AS_IS_VARIANT;
+    auto inflectedWord = inflectInflectionCandidates(&candidates, variants, &inflectedVariant, constraints, optionalConstraints, constraintGrammemes, traceEnabled);
+    if (inflectedWord.has_value() && inflectedVariant == LOWERCASED_VARIANT) {
         //If word all caps then make inflection all upper case
         if (allCaps) {
             ::std::u16string upperCaseInflectedWord;
@@ -164,13 +302,12 @@ static void traceLogSortedInflectionGrammemes(const ::std::vector<::inflection::
             //If word is capitalized first then inflection is capitalized first
             inflectedWord = inflection::util::StringViewUtils::capitalizeFirst(*inflectedWord, locale);
         }
-        return inflectedWord;
     }
-    return {};
+    return inflectedWord;
 }
 
 ::std::optional<::std::u16string> DictionaryLookupInflector::inflectWord(std::u16string_view word, int64_t wordGrammemes, const ::std::vector<::std::u16string> &constraints, const std::vector<::std::u16string> &disambiguationGrammemeValues) const {
-    return inflectWordImplementation(word, wordGrammemes, constraints, {}, disambiguationGrammemeValues);
+    return inflectWordImplementation(word, wordGrammemes, constraints, {}, disambiguationGrammemeValues, resolveConstraintGrammemes(constraints, {}, disambiguationGrammemeValues));
 }
 
 int64_t DictionaryLookupInflector::disambiguationMatchScore(int64_t grammemes, const std::vector<int64_t> &disambiguationGrammemes) {
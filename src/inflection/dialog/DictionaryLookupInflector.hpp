@@ -11,8 +11,10 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <optional>
+#include <span>
 
-class inflection::dialog::DictionaryLookupInflector
+class INFLECTION_INTERNAL_API inflection::dialog::DictionaryLookupInflector
     : public ::inflection::analysis::MorphologicalAnalyzer
 {
 public:
@@ -22,9 +24,30 @@ private:
     bool enableDictionaryFallback;
 
 private:
+    /**
+     * The binary values of the constraints of an inflect call. They are resolved once for each call, and not for each
+     * case variant of the word or for each inflection candidate.
+     */
+    struct ConstraintGrammemes {
+        ::std::optional<int64_t> constraints {  };
+        ::std::vector<int64_t> optionalConstraints {  };
+        ::std::vector<int64_t> disambiguationGrammemes {  };
+    };
+    ConstraintGrammemes resolveConstraintGrammemes(const std::vector<::std::u16string> &constraints, const std::vector<std::u16string> &optionalConstraints, const std::vector<::std::u16string> &disambiguationGrammemeValues) const;
     int8_t compareInflectionGrammemes(const ::inflection::analysis::DictionaryExposableMorphology::InflectionGrammemes &inflectionGrammemes1, const ::inflection::analysis::DictionaryExposableMorphology::InflectionGrammemes &inflectionGrammemes2, const std::vector<int64_t> &disambiguationGrammemes) const;
     static int64_t disambiguationMatchScore(int64_t grammemes, const ::std::vector<int64_t> &disambiguationGrammemes);
-    ::std::optional<::std::u16string> inflectWordImplementation(std::u16string_view word, int64_t wordGrammemes, const std::vector<::std::u16string> &constraints, const std::vector<std::u16string> &optionalConstraints, const std::vector<::std::u16string> &disambiguationGrammemeValues) const;
+    struct InflectionCandidates;
+    /**
+     * Add the inflection candidates of one case variant of the word. The candidates of a lower variant are tried first.
+     */
+    void collectInflectionCandidates(InflectionCandidates* candidates, std::u16string_view word, int32_t variant, int64_t wordGrammemes, bool traceEnabled) const;
+    /**
+     * Sort the candidates of every case variant at once, and reinflect them in order until one succeeds.
+     * @param variants The case variants of the word, indexed by the variant of each candidate.
+     * @param inflectedVariant Set to the variant of the candidate that was inflected.
+     */
+    ::std::optional<::std::u16string> inflectInflectionCandidates(InflectionCandidates* candidates, ::std::span<const ::std::u16string_view> variants, int32_t* inflectedVariant, const std::vector<::std::u16string> &constraints, const std::vector<std::u16string> &optionalConstraints, const ConstraintGrammemes &constraintGrammemes, bool traceEnabled) const;
+    ::std::optional<::std::u16string> inflectWordImplementation(std::u16string_view word, int64_t wordGrammemes, const std::vector<::std::u16string> &constraints, const std::vector<std::u16string> &optionalConstraints, const std::vector<::std::u16string> &disambiguationGrammemeValues, const ConstraintGrammemes &constraintGrammemes) const;
 public:
     ::std::optional<::std::u16string> inflect(std::u16string_view word, int64_t wordGrammemes, const std::vector<::std::u16string> &constraints, const std::vector<::std::u16string> &disambiguationGrammemeValues = {}) const;
     
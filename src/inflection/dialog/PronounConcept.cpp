@@ -11,9 +11,12 @@
 #include <inflection/exception/IllegalArgumentException.hpp>
 #include <inflection/exception/InvalidConfigurationException.hpp>
 #include <inflection/resources/DataResource.hpp>
+#include <inflection/resources/MemoryBudget.hpp>
 #include <inflection/util/ArrayUtils.hpp>
 #include <inflection/util/DelimitedStringIterator.hpp>
+#include <inflection/util/MemoryUsage.hpp>
 #include <inflection/util/StringViewUtils.hpp>
+#include <inflection/util/ULocale.hpp>
 #include <inflection/npc.hpp>
 #include <unicode/ustring.h>
 #include <unicode/stringoptions.h>
@@ -141,6 +144,8 @@ std::map<std::u16string, std::shared_ptr<PronounConcept::DefaultPronounData>>* P
 }
 
 std::shared_ptr<PronounConcept::DefaultPronounData> PronounConcept::getPronounData(const SemanticFeatureModel& model) {
+    // Declared first, so that the budget is enforced after the lock is released.
+    ::inflection::resources::MemoryBudget::LoadScope loadScope;
     std::lock_guard<std::mutex> guard(CLASS_MUTEX());
     const auto pronounDataCache = PRONOUN_DATA_CACHE();
     const auto [pronounLocale, reader] = getPronounTable(model.getLocale());
@@ -151,6 +156,60 @@ std::shared_ptr<PronounConcept::DefaultPronounData> PronounConcept::getPronounDa
     return pronounDataItr->second;
 }
 
+int64_t PronounConcept::estimateHeapBytes(const std::u16string& pronounLocale, const PronounConcept::DefaultPronounData& defaultPronounData) {
+    size_t heapBytes = pronounLocale.capacity() * sizeof(char16_t) + sizeof(DefaultPronounData);
+    heapBytes += defaultPronounData.data.capacity() * sizeof(PronounEntry);
+    for (const auto& [word, constraints] : defaultPronounData.data) {
+        heapBytes += ::inflection::util::MemoryUsage::estimateNodeHeapBytes(constraints);
+    }
+    heapBytes += defaultPronounData.singletons.capacity() * sizeof(defaultPronounData.singletons[0]);
+    for (const auto& singleton : defaultPronounData.singletons) {
+        heapBytes += sizeof(*singleton) + singleton->capacity() * sizeof(char16_t);
+    }
+    return int64_t(heapBytes);
+}
+
+int64_t PronounConcept::getCachedMemory(std::string_view language) {
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    int64_t heapBytes = 0;
+    for (const auto& [pronounLocale, defaultPronounData] : *PRONOUN_DATA_CACHE()) {
+        if (util::ULocale(util::StringViewUtils::to_string(pronounLocale)).getLanguage() == language) {
+            heapBytes += estimateHeapBytes(pronounLocale, *npc(defaultPronounData.get()));
+        }
+    }
+    return heapBytes;
+}
+
+int64_t PronounConcept::evictPronounData(std::string_view language) {
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    const auto pronounDataCache = PRONOUN_DATA_CACHE();
+    int64_t releasedBytes = 0;
+    for (auto pronounDataItr = pronounDataCache->begin(); pronounDataItr != pronounDataCache->end();) {
+        // PronounConcept objects share the data, so it's deleted after they are.
+        if (util::ULocale(util::StringViewUtils::to_string(pronounDataItr->first)).getLanguage() == language) {
+            // New references are only made while holding the lock, so unshared data is deleted here.
+            if (pronounDataItr->second.use_count() == 1) {
+                releasedBytes += estimateHeapBytes(pronounDataItr->first, *npc(pronounDataItr->second.get()));
+            }
+            pronounDataItr = pronounDataCache->erase(pronounDataItr);
+        }
+        else {
+            ++pronounDataItr;
+        }
+    }
+    return releasedBytes;
+}
+
+void PronounConcept::getCacheMemoryUsage(::inflection::util::MemoryUsage* usage) {
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    const auto pronounDataCache = PRONOUN_DATA_CACHE();
+    int64_t heapBytes = int64_t(::inflection::util::MemoryUsage::estimateNodeHeapBytes(*pronounDataCache));
+    for (const auto& [pronounLocale, defaultPronounData] : *pronounDataCache) {
+        heapBytes += estimateHeapBytes(pronounLocale, *npc(defaultPronounData.get()));
+    }
+    npc(usage)->addHeap("pronoun data cache", size_t(heapBytes));
+}
+
 class PronounConcept::PronounData {
     std::shared_ptr<DefaultPronounData> defaultPronounData;
     std::vector<PronounEntry> customizedPronounData {  };
@@ -7,9 +7,12 @@
 #include <inflection/dialog/SemanticFeatureConceptBase.hpp>
 #include <inflection/dialog/SemanticFeatureModel_DisplayData.hpp>
 #include <inflection/dialog/DisplayValue.hpp>
+#include <inflection/resources/fwd.hpp>
+#include <inflection/util/fwd.hpp>
 #include <optional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 /**
@@ -145,8 +148,29 @@ public:
      * The destructor
      */
     ~PronounConcept() override;
+
+    /**
+     * Add the estimated heap memory of the cached pronoun data shared by all PronounConcept objects.
+     */
+    static void getCacheMemoryUsage(::inflection::util::MemoryUsage* usage);
 private:
     static std::map<std::u16string, std::shared_ptr<PronounConcept::DefaultPronounData>>* PRONOUN_DATA_CACHE();
+    /**
+     * Returns the estimated heap memory of a cache entry.
+     */
+    static int64_t estimateHeapBytes(const std::u16string& pronounLocale, const PronounConcept::DefaultPronounData& defaultPronounData);
+    /**
+     * Returns the estimated heap memory of the cached pronoun data of the language.
+     */
+    static int64_t getCachedMemory(std::string_view language);
+    /**
+     * Remove the cached pronoun data of the language. It's created again when it's needed.
+     * The data is released after the PronounConcept objects that share it are deleted.
+     * @return the estimated heap memory that was released.
+     */
+    static int64_t evictPronounData(std::string_view language);
 
     PronounConcept& operator=(const PronounConcept&) = delete;
+
+    friend class ::inflection::resources::MemoryBudget;
 };
@@ -4,12 +4,14 @@
 #include <inflection/dictionary/DictionaryKeyIterator.hpp>
 
 #include <inflection/dictionary/metadata/MarisaTrieIterator.hpp>
+#include <inflection/util/ShardedCounter_Reference.hpp>
 #include <inflection/npc.hpp>
 
 namespace inflection::dictionary {
 
-DictionaryKeyIterator::DictionaryKeyIterator(const metadata::MarisaTrieIterator<uint64_t>& trieIterator)
-    : trieIterator(new metadata::MarisaTrieIterator<uint64_t>(trieIterator.trie, trieIterator.prefix))
+DictionaryKeyIterator::DictionaryKeyIterator(const metadata::MarisaTrieIterator<uint64_t>& trieIterator, ::inflection::util::ShardedCounter_Reference* reference)
+    : reference(npc(reference))
+    , trieIterator(new metadata::MarisaTrieIterator<uint64_t>(trieIterator.begin()))
 {
     // Skip the empty string
     if (operator*().empty() && trieIterator.prefix.empty()) {
@@ -18,7 +20,8 @@ DictionaryKeyIterator::DictionaryKeyIterator(const metadata::MarisaTrieIterator<
 }
 
 DictionaryKeyIterator::DictionaryKeyIterator(DictionaryKeyIterator&& iterator)
-    : trieIterator(npc(iterator.trieIterator.release()))
+    : reference(npc(iterator.reference.release()))
+    , trieIterator(npc(iterator.trieIterator.release()))
 {
 }
 
@@ -33,7 +36,10 @@ DictionaryKeyIterator::operator*() const {
 
 DictionaryKeyIterator&
 DictionaryKeyIterator::operator++() {
-    ++*trieIterator;
+    // Skip the empty string, which can be anywhere in a key id range.
+    do {
+        ++*trieIterator;
+    } while (!trieIterator->reachedEnd && trieIterator->agent.key().length() == 0);
     return *this;
 }
 
@@ -45,13 +51,13 @@ DictionaryKeyIterator::operator==(const DictionaryKeyIterator& rhs) const {
 DictionaryKeyIterator
 DictionaryKeyIterator::begin() const
 {
-    return DictionaryKeyIterator(trieIterator->begin());
+    return DictionaryKeyIterator(trieIterator->begin(), new ::inflection::util::ShardedCounter_Reference(*npc(reference.get())));
 }
 
 DictionaryKeyIterator
 DictionaryKeyIterator::end() const
 {
-    return DictionaryKeyIterator(trieIterator->end());
+    return DictionaryKeyIterator(trieIterator->end(), new ::inflection::util::ShardedCounter_Reference(*npc(reference.get())));
 }
 
 } // namespace inflection::dictionary
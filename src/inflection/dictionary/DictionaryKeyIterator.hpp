@@ -5,6 +5,7 @@
 
 #include <inflection/dictionary/metadata/fwd.hpp>
 #include <inflection/dictionary/fwd.hpp>
+#include <inflection/util/fwd.hpp>
 #include <inflection/Object.hpp>
 #include <cstdint>
 #include <memory>
@@ -51,7 +52,7 @@ public:
      */
     DictionaryKeyIterator    begin() const;
     /**
-     * The last word in the dictionary.
+     * The end of the words in the dictionary.
      */
     DictionaryKeyIterator    end() const;
 
@@ -59,8 +60,13 @@ public:
     DictionaryKeyIterator& operator=(const DictionaryKeyIterator&) = delete;
 private:
 
-    explicit DictionaryKeyIterator(const ::inflection::dictionary::metadata::MarisaTrieIterator<uint64_t>& trieIterator);
+    /**
+     * Takes ownership of the reference, which keeps the dictionary of the trie mapped while this iterator exists.
+     */
+    explicit DictionaryKeyIterator(const ::inflection::dictionary::metadata::MarisaTrieIterator<uint64_t>& trieIterator, ::inflection::util::ShardedCounter_Reference* reference);
 
+    // This is declared first so that it's destroyed after the trie iterator.
+    std::unique_ptr<::inflection::util::ShardedCounter_Reference> reference {  };
     std::unique_ptr<::inflection::dictionary::metadata::MarisaTrieIterator<uint64_t>> trieIterator {  };
 
     friend class DictionaryMetaData_MMappedDictionary;
@@ -4,18 +4,25 @@
 #include <inflection/dictionary/DictionaryMetaData.hpp>
 
 #include <inflection/dictionary/DictionaryMetaData_MMappedDictionary.hpp>
+#include <inflection/dictionary/DictionaryMetaData_ReadGuard.hpp>
+#include <inflection/dictionary/Inflector.hpp>
 #include <inflection/lang/features/LanguageGrammarFeatures.hpp>
+#include <inflection/resources/MemoryBudget.hpp>
 #include <inflection/exception/IOException.hpp>
 #include <inflection/exception/IllegalArgumentException.hpp>
 #include <inflection/util/AutoFileDescriptor.hpp>
 #include <inflection/util/ResourceLocator.hpp>
 #include <inflection/util/LocaleUtils.hpp>
+#include <inflection/util/MemoryMappedFile.hpp>
+#include <inflection/util/MemoryUsage.hpp>
 #include <inflection/util/Logger.hpp>
 #include <inflection/util/LoggerConfig.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/ULocale.hpp>
 #include <inflection/npc.hpp>
+#include <atomic>
 #include <mutex>
+#include <thread>
 
 namespace inflection::dictionary {
 
@@ -24,14 +31,170 @@ static std::mutex& CLASS_MUTEX() {
     return *npc(classMutex);
 }
 
-DictionaryMetaData::DictionaryMetaData(DictionaryMetaData_MMappedDictionary* dictionary)
+/**
+ * Serializes the changes to the current dictionary of each DictionaryMetaData. This is held while waiting for readers,
+ * so nothing that a reader may wait for can be done while holding it.
+ */
+static std::mutex& SWAP_MUTEX() {
+    static auto swapMutex = new std::mutex();
+    return *npc(swapMutex);
+}
+
+/**
+ * Advanced for every pass over the loaded dictionaries. Lookups record the current value, which is enough to order
+ * the dictionaries by how recently they were used without contending on a shared counter.
+ */
+static ::std::atomic<int64_t>& USE_TICK() {
+    static auto useTick = new ::std::atomic<int64_t>(1);
+    return *npc(useTick);
+}
+
+/**
+ * The epoch that new readers start in. It is advanced by every swap, and a swap waits for the readers that started in
+ * an earlier epoch.
+ */
+static ::std::atomic<uint64_t>& READ_EPOCH() {
+    static auto readEpoch = new ::std::atomic<uint64_t>(1);
+    return *npc(readEpoch);
+}
+
+/**
+ * The read state of one thread. Only the owning thread writes it, so a lookup never writes a cache line that another
+ * thread reads or writes, except for a swap that scans it.
+ */
+struct alignas(64) DictionaryMetaData::ReadGuard::ReaderSlot {
+    /** The epoch that the outermost lookup of the thread started in, or 0 when the thread is not reading. */
+    ::std::atomic<uint64_t> epoch { 0 };
+    /** The number of nested lookups. */
+    int32_t depth { 0 };
+    /** Set while a thread owns this slot. This is guarded by READER_SLOTS_MUTEX. */
+    bool owned { false };
+};
+
+static std::mutex& READER_SLOTS_MUTEX() {
+    static auto readerSlotsMutex = new std::mutex();
+    return *npc(readerSlotsMutex);
+}
+
+/**
+ * The slots of all threads that ever read a dictionary. A slot is reused by a new thread after its thread exits,
+ * so this is bounded by the largest number of threads that read at the same time.
+ */
+::std::vector<DictionaryMetaData::ReadGuard::ReaderSlot*>& DictionaryMetaData::ReadGuard::READER_SLOTS() {
+    static auto readerSlots = new ::std::vector<ReaderSlot*>();
+    return *npc(readerSlots);
+}
+
+class DictionaryMetaData::ReadGuard::ThreadReaderSlot final {
+public:
+    ThreadReaderSlot()
+    {
+        std::lock_guard<std::mutex> guard(READER_SLOTS_MUTEX());
+        for (auto readerSlot : READER_SLOTS()) {
+            if (!readerSlot->owned) {
+                slot = readerSlot;
+                break;
+            }
+        }
+        if (slot == nullptr) {
+            slot = new ReaderSlot();
+            READER_SLOTS().push_back(slot);
+        }
+        slot->owned = true;
+    }
+    ~ThreadReaderSlot()
+    {
+        std::lock_guard<std::mutex> guard(READER_SLOTS_MUTEX());
+        slot->owned = false;
+    }
+    ReaderSlot& operator*() const
+    {
+        return *slot;
+    }
+
+private:
+    ThreadReaderSlot(const ThreadReaderSlot&) = delete;
+    ThreadReaderSlot& operator=(const ThreadReaderSlot&) = delete;
+
+    ReaderSlot* slot {  };
+};
+
+DictionaryMetaData::ReadGuard::ReaderSlot& DictionaryMetaData::ReadGuard::getThreadReaderSlot() {
+    static thread_local ThreadReaderSlot threadReaderSlot;
+    return *threadReaderSlot;
+}
+
+void DictionaryMetaData::ReadGuard::beginRead(ReaderSlot& slot) {
+    if (slot.depth++ == 0) {
+        // Reading the epoch with acquire ordering means that a reader that sees a new epoch also sees the dictionary
+        // that was published before it was advanced.
+        slot.epoch.store(READ_EPOCH().load(::std::memory_order_acquire));
+    }
+}
+
+void DictionaryMetaData::ReadGuard::endRead(ReaderSlot& slot) {
+    if (--slot.depth == 0) {
+        slot.epoch.store(0, ::std::memory_order_release);
+    }
+}
+
+DictionaryMetaData::ReadGuard::ReadGuard(const DictionaryMetaData& metaData)
+    : slot(getThreadReaderSlot())
+{
+    while (true) {
+        beginRead(slot);
+        // This is loaded after the epoch is published so that a swap either waits for us or we see its replacement.
+        dictionary = metaData.currentDictionary.load();
+        if (dictionary != nullptr) {
+            break;
+        }
+        // It was evicted.
+        endRead(slot);
+        metaData.reloadDictionary();
+    }
+    auto useTick = USE_TICK().load(::std::memory_order_relaxed);
+    if (metaData.lastUsed.load(::std::memory_order_relaxed) != useTick) {
+        metaData.lastUsed.store(useTick, ::std::memory_order_relaxed);
+    }
+}
+
+DictionaryMetaData::ReadGuard::~ReadGuard()
+{
+    endRead(slot);
+}
+
+void DictionaryMetaData::ReadGuard::waitForReaders()
+{
+    // Readers that start after this see the replacement.
+    const auto epoch = READ_EPOCH().fetch_add(1) + 1;
+    ::std::vector<ReaderSlot*> readerSlots;
+    {
+        std::lock_guard<std::mutex> guard(READER_SLOTS_MUTEX());
+        readerSlots = READER_SLOTS();
+    }
+    for (auto readerSlot : readerSlots) {
+        while (true) {
+            auto readerEpoch = readerSlot->epoch.load();
+            if (readerEpoch == 0 || readerEpoch >= epoch) {
+                break;
+            }
+            ::std::this_thread::yield();
+        }
+    }
+}
+
+DictionaryMetaData::DictionaryMetaData(const ::inflection::util::ULocale& locale, DictionaryMetaData_MMappedDictionary* dictionary)
     : super()
-    , dictionary(npc(dictionary))
+    , localeName(locale.getName())
+    , currentDictionary(npc(dictionary))
+    , lastUsed(USE_TICK().load(::std::memory_order_relaxed))
+    , inflector(new Inflector(*this))
 {
 }
 
 DictionaryMetaData::~DictionaryMetaData()
 {
+    delete currentDictionary.load();
 }
 
 static constexpr char16_t FILE_EXTENSION[] = { u".sdict" };
@@ -69,58 +232,260 @@ static void logEmptyDictionaryWarning(const ::inflection::util::ULocale &locale,
     }
 }
 
+static ::std::map<::std::string, int32_t, std::less<>>& RESIDENCY_POLICIES()
+{
+    static auto RESIDENCY_POLICIES_ = new ::std::map<::std::string, int32_t, std::less<>>();
+    return *npc(RESIDENCY_POLICIES_);
+}
+
+static int32_t getResidencyPolicy(std::string_view language) {
+    auto residencyPolicyResult = RESIDENCY_POLICIES().find(language);
+    if (residencyPolicyResult != RESIDENCY_POLICIES().end()) {
+        return residencyPolicyResult->second;
+    }
+    return ::inflection::util::MemoryMappedFile::getDefaultResidencyPolicy();
+}
+
 static DictionaryMetaData_MMappedDictionary* createDictionaryForLocale(const ::inflection::util::ULocale& locale) {
     ::inflection::util::ULocale genericLanguage(locale.getLanguage());
+    auto residencyPolicy = getResidencyPolicy(genericLanguage.getLanguage());
     try {
         auto path(getResourcePath(genericLanguage));
         if (!inflection::util::AutoFileDescriptor::isAccessibleFile(path)) {
             // This rarely happens, unless a fallback is needed. Calculate the fallback.
             path = getResourcePath(getLanguageWithFallback(locale));
         }
-        return DictionaryMetaData_MMappedDictionary::createDictionary(path);
+        return DictionaryMetaData_MMappedDictionary::createDictionary(path, residencyPolicy);
     } catch (const ::inflection::exception::IOException& e) {
         logEmptyDictionaryWarning(locale, e);
         return new DictionaryMetaData_MMappedDictionary(locale);
     }
 }
 
-static ::std::map<::std::string, DictionaryMetaData*, std::less<>>* DICTIONARY_CACHE()
+typedef ::std::map<::std::string, DictionaryMetaData*, std::less<>> DictionaryCache;
+
+/**
+ * The cache is a copy-on-write snapshot. A published snapshot is never modified,
+ * which lets readers find an already loaded dictionary without taking CLASS_MUTEX.
+ */
+static ::std::atomic<const DictionaryCache*>& DICTIONARY_CACHE()
 {
-    static auto DICTIONARY_CACHE_ = new ::std::map<::std::string, DictionaryMetaData*, std::less<>>();
-    return DICTIONARY_CACHE_;
+    static auto DICTIONARY_CACHE_ = new ::std::atomic<const DictionaryCache*>(new DictionaryCache());
+    return *npc(DICTIONARY_CACHE_);
 }
 
 const DictionaryMetaData* DictionaryMetaData::createDictionary(const ::inflection::util::ULocale& locale)
 {
-    DictionaryMetaData* result;
-    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
-    auto dictionaryCache = DICTIONARY_CACHE();
-    auto existingDictionary = dictionaryCache->find(locale.getLanguage());
+    auto language(locale.getLanguage());
+    auto dictionaryCache = DICTIONARY_CACHE().load(::std::memory_order_acquire);
+    auto existingDictionary = npc(dictionaryCache)->find(language);
     if (existingDictionary != dictionaryCache->end()) {
-        result = existingDictionary->second;
+        return existingDictionary->second;
     }
-    else {
-        result = new DictionaryMetaData(createDictionaryForLocale(locale));
-        dictionaryCache->emplace(locale.getLanguage(), result);
+
+    std::unique_lock<std::mutex> guard(CLASS_MUTEX());
+    // Another thread may have loaded it while we were waiting.
+    dictionaryCache = DICTIONARY_CACHE().load(::std::memory_order_relaxed);
+    existingDictionary = npc(dictionaryCache)->find(language);
+    if (existingDictionary != dictionaryCache->end()) {
+        return existingDictionary->second;
     }
+    auto result = new DictionaryMetaData(locale, createDictionaryForLocale(locale));
+    auto updatedCache = new DictionaryCache(*dictionaryCache);
+    updatedCache->emplace(language, result);
+    // The previous snapshot is intentionally not deleted. Readers may still be searching it,
+    // and it is bounded by the small number of languages that are ever loaded.
+    DICTIONARY_CACHE().store(updatedCache, ::std::memory_order_release);
+    guard.unlock();
+    ::inflection::resources::MemoryBudget::resourceLoaded(language, false);
     return result;
 }
 
+void DictionaryMetaData::setResidencyPolicy(const ::inflection::util::ULocale& locale, int32_t residencyPolicy)
+{
+    auto language(locale.getLanguage());
+    // SWAP_MUTEX prevents the current dictionary from being unmapped while the policy is applied.
+    std::lock_guard<std::mutex> swapGuard(SWAP_MUTEX());
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    RESIDENCY_POLICIES()[::std::string(language)] = residencyPolicy;
+    auto dictionaryCache = DICTIONARY_CACHE().load(::std::memory_order_relaxed);
+    auto existingDictionary = npc(dictionaryCache)->find(language);
+    if (existingDictionary != dictionaryCache->end()) {
+        auto currentDictionary = npc(existingDictionary->second)->currentDictionary.load();
+        if (currentDictionary != nullptr) {
+            currentDictionary->applyResidencyPolicy(residencyPolicy);
+        }
+    }
+}
+
+void DictionaryMetaData::replaceDictionary(const ::inflection::util::ULocale& locale, const ::std::u16string& path)
+{
+    auto language(locale.getLanguage());
+    std::lock_guard<std::mutex> swapGuard(SWAP_MUTEX());
+    DictionaryMetaData* existingMetaData = nullptr;
+    ::std::unique_ptr<DictionaryMetaData_MMappedDictionary> replacement;
+    {
+        std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+        // Load it before publishing anything, so that a bad file leaves the current dictionary in place.
+        replacement.reset(DictionaryMetaData_MMappedDictionary::createDictionary(path, getResidencyPolicy(language)));
+        auto dictionaryCache = DICTIONARY_CACHE().load(::std::memory_order_relaxed);
+        auto existingDictionary = npc(dictionaryCache)->find(language);
+        if (existingDictionary == dictionaryCache->end()) {
+            auto result = new DictionaryMetaData(locale, replacement.release());
+            result->replacementPath = path;
+            auto updatedCache = new DictionaryCache(*dictionaryCache);
+            updatedCache->emplace(language, result);
+            DICTIONARY_CACHE().store(updatedCache, ::std::memory_order_release);
+            return;
+        }
+        existingMetaData = npc(existingDictionary->second);
+        // Some languages fall back to the dictionary of another language, so compare with what is used now.
+        auto currentDictionary = existingMetaData->currentDictionary.load();
+        if (currentDictionary != nullptr && replacement->getLocale().getLanguage() != currentDictionary->getLocale().getLanguage()) {
+            throw ::inflection::exception::IllegalArgumentException(u"The dictionary " + path + u" is for "
+                + replacement->getLocale().toString() + u" instead of " + currentDictionary->getLocale().toString());
+        }
+        // An evicted dictionary is reloaded from here.
+        existingMetaData->replacementPath = path;
+    }
+    // Readers may need CLASS_MUTEX to reload, so it's not held while waiting for them.
+    existingMetaData->swapDictionary(replacement.release());
+}
+
+/**
+ * Delete the dictionary, and return the resident and heap memory that this released.
+ */
+static int64_t releaseDictionary(::std::unique_ptr<DictionaryMetaData_MMappedDictionary> dictionary)
+{
+    ::inflection::util::MemoryUsage usage;
+    npc(dictionary.get())->addMemoryUsage(&usage);
+    // The pages are released when the mapping is deleted, even when the mapping is a section of a bundle.
+    dictionary.reset();
+    return int64_t(usage.getResidentBytes() + usage.getHeapBytes());
+}
+
+int64_t DictionaryMetaData::swapDictionary(DictionaryMetaData_MMappedDictionary* replacement)
+{
+    ::std::unique_ptr<DictionaryMetaData_MMappedDictionary> previous(currentDictionary.exchange(replacement));
+    if (previous == nullptr) {
+        // It was evicted. Readers that saw that are reloading, and they don't use a dictionary.
+        return releaseRetiredDictionaries();
+    }
+    ReadGuard::waitForReaders();
+    // No new reference can be made to the previous dictionary now, so it stays unreferenced once it is.
+    if (!previous->references.isZero()) {
+        retiredDictionaries.emplace_back(::std::move(previous));
+        return releaseRetiredDictionaries();
+    }
+    // Otherwise the previous dictionary is quiescent, and it's unmapped now.
+    return releaseDictionary(::std::move(previous)) + releaseRetiredDictionaries();
+}
+
+int64_t DictionaryMetaData::releaseRetiredDictionaries()
+{
+    int64_t releasedBytes = 0;
+    ::std::erase_if(retiredDictionaries, [&releasedBytes](::std::unique_ptr<DictionaryMetaData_MMappedDictionary>& retiredDictionary) {
+        if (!retiredDictionary->references.isZero()) {
+            return false;
+        }
+        releasedBytes += releaseDictionary(::std::move(retiredDictionary));
+        return true;
+    });
+    return releasedBytes;
+}
+
+void DictionaryMetaData::reloadDictionary() const
+{
+    {
+        std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+        if (currentDictionary.load() != nullptr) {
+            // Another thread reloaded it while we were waiting.
+            return;
+        }
+        ::inflection::util::ULocale locale(localeName);
+        ::std::unique_ptr<DictionaryMetaData_MMappedDictionary> reloaded;
+        if (!replacementPath.empty()) {
+            try {
+                reloaded.reset(DictionaryMetaData_MMappedDictionary::createDictionary(replacementPath, getResidencyPolicy(locale.getLanguage())));
+            } catch (const ::inflection::exception::IOException& e) {
+                logEmptyDictionaryWarning(locale, e);
+                reloaded.reset(new DictionaryMetaData_MMappedDictionary(locale));
+            }
+        }
+        else {
+            reloaded.reset(createDictionaryForLocale(locale));
+        }
+        DictionaryMetaData_MMappedDictionary* expected = nullptr;
+        // A replacement may have been swapped in without CLASS_MUTEX. That one wins.
+        if (!currentDictionary.compare_exchange_strong(expected, reloaded.get())) {
+            return;
+        }
+        reloaded.release();
+    }
+    ::inflection::resources::MemoryBudget::resourceLoaded(::inflection::util::ULocale(localeName).getLanguage(), true);
+}
+
+void DictionaryMetaData::getLoadedDictionaries(::std::vector<LoadedDictionary>* result)
+{
+    npc(result)->clear();
+    std::lock_guard<std::mutex> swapGuard(SWAP_MUTEX());
+    auto dictionaryCache = DICTIONARY_CACHE().load(::std::memory_order_acquire);
+    for (const auto& [language, metaData] : *npc(dictionaryCache)) {
+        npc(metaData)->releaseRetiredDictionaries();
+        auto currentDictionary = metaData->currentDictionary.load();
+        if (currentDictionary == nullptr && metaData->retiredDictionaries.empty()) {
+            continue;
+        }
+        ::inflection::util::MemoryUsage usage;
+        if (currentDictionary != nullptr) {
+            currentDictionary->addMemoryUsage(&usage);
+        }
+        // These are still mapped, and they are released by the eviction that follows their last reference.
+        for (const auto& retiredDictionary : metaData->retiredDictionaries) {
+            retiredDictionary->addMemoryUsage(&usage);
+        }
+        result->push_back({metaData->lastUsed.load(::std::memory_order_relaxed), language, int64_t(usage.getResidentBytes() + usage.getHeapBytes())});
+    }
+    // Lookups from now on are more recent than anything that was just reported.
+    USE_TICK().fetch_add(1);
+}
+
+int64_t DictionaryMetaData::evictDictionary(std::string_view language)
+{
+    std::lock_guard<std::mutex> swapGuard(SWAP_MUTEX());
+    auto dictionaryCache = DICTIONARY_CACHE().load(::std::memory_order_acquire);
+    auto existingDictionary = npc(dictionaryCache)->find(language);
+    if (existingDictionary == dictionaryCache->end()) {
+        return 0;
+    }
+    return npc(existingDictionary->second)->swapDictionary(nullptr);
+}
+
 ::std::u16string* DictionaryMetaData::transform(::std::u16string* dest, std::u16string_view str, const ::inflection::util::ULocale& locale)
 {
     return ::inflection::util::StringViewUtils::lowercase(dest, str, locale);
 }
 
+::std::optional<int64_t> DictionaryMetaData::getLowercaseWordType(const DictionaryMetaData_MMappedDictionary& dictionary, std::u16string_view word)
+{
+    if (!dictionary.needsLowercaseRetry(word)) {
+        return {};
+    }
+    ::std::u16string normalized;
+    transform(&normalized, word, dictionary.getLocale());
+    if (normalized != word) {
+        return dictionary.getWordType(normalized);
+    }
+    return {};
+}
+
 int64_t* DictionaryMetaData::getCombinedBinaryType(int64_t* result, std::u16string_view word) const
 {
+    ReadGuard dictionary(*this);
     *npc(result) = 0;
     auto combinedType = dictionary->getWordType(word);
     if (!combinedType) {
-        ::std::u16string normalized;
-        transform(&normalized, word, dictionary->getLocale());
-        if (normalized != word) {
-            combinedType = dictionary->getWordType(normalized);
-        }
+        combinedType = getLowercaseWordType(*dictionary, word);
     }
     if (!combinedType) {
         return nullptr;
@@ -131,22 +496,68 @@ int64_t* DictionaryMetaData::getCombinedBinaryType(int64_t* result, std::u16stri
 
 ::std::vector<::std::u16string> DictionaryMetaData::getPropertyNames(int64_t binaryProperties) const
 {
+    ReadGuard dictionary(*this);
     return dictionary->getTypesOfValues(binaryProperties);
 }
 
 ::std::u16string DictionaryMetaData::getPropertyName(int64_t singleProperty) const
 {
+    ReadGuard dictionary(*this);
     return dictionary->getTypeOfValue(singleProperty).value_or(std::u16string());
 }
 
+int64_t* DictionaryMetaData::getCombinedBinaryType(int64_t* result, std::string_view word) const
+{
+    ReadGuard dictionary(*this);
+    *npc(result) = 0;
+    auto combinedType = dictionary->getWordType(word);
+    if (!combinedType) {
+        // Lowercasing is locale sensitive, and it is done in UTF-16. The word as is was already missed.
+        combinedType = getLowercaseWordType(*dictionary, inflection::util::StringViewUtils::to_u16string(word));
+    }
+    if (!combinedType) {
+        return nullptr;
+    }
+    *npc(result) = *combinedType;
+    return result;
+}
+
+void DictionaryMetaData::getCombinedBinaryTypes(::std::span<int64_t> results, ::std::span<const ::std::u16string_view> words) const
+{
+    ReadGuard dictionary(*this);
+    if (results.size() != words.size()) {
+        throw ::inflection::exception::IllegalArgumentException(u"The number of results must match the number of words");
+    }
+    ::std::string encodedBuffer;
+    ::std::u16string normalized;
+    for (size_t idx = 0; idx < words.size(); idx++) {
+        const auto word = words[idx];
+        auto combinedType = dictionary->getWordType(word, &encodedBuffer);
+        if (!combinedType && dictionary->needsLowercaseRetry(word)) {
+            transform(&normalized, word, dictionary->getLocale());
+            if (normalized != word) {
+                combinedType = dictionary->getWordType(normalized, &encodedBuffer);
+            }
+        }
+        results[idx] = combinedType.value_or(0);
+    }
+}
+
 bool DictionaryMetaData::isKnownWord(std::u16string_view word) const
 {
     int64_t combinedType = 0;
     return getCombinedBinaryType(&combinedType, word) != nullptr;
 }
 
+bool DictionaryMetaData::isKnownWord(std::string_view word) const
+{
+    int64_t combinedType = 0;
+    return getCombinedBinaryType(&combinedType, word) != nullptr;
+}
+
 bool DictionaryMetaData::hasProperty(std::u16string_view word, std::u16string_view partOfSpeech) const
 {
+    ReadGuard dictionary(*this);
     auto property = dictionary->getValueOfType(partOfSpeech);
     if (!property) {
         return false;
@@ -180,6 +591,7 @@ int64_t DictionaryMetaData::getBinaryProperties(const ::std::vector<::std::u16st
 
 int64_t* DictionaryMetaData::getBinaryProperties(int64_t* result, const ::std::vector<::std::u16string>& properties) const
 {
+    ReadGuard dictionary(*this);
     *npc(result) = dictionary->getValuesOfTypes(properties);
     if (*npc(result) == 0) {
         return nullptr;
@@ -187,6 +599,12 @@ int64_t* DictionaryMetaData::getBinaryProperties(int64_t* result, const ::std::v
     return result;
 }
 
+void DictionaryMetaData::getBinaryPropertiesOfEach(::std::vector<int64_t>* result, const ::std::vector<::std::u16string>& properties) const
+{
+    ReadGuard dictionary(*this);
+    dictionary->getValueOfEachType(result, properties);
+}
+
 ::std::vector<::std::u16string> DictionaryMetaData::getProperties(std::u16string_view word) const
 {
     int64_t combinedType = 0;
@@ -205,11 +623,12 @@ int64_t* DictionaryMetaData::getBinaryProperties(int64_t* result, const ::std::v
 
 bool DictionaryMetaData::getPropertyValues(::std::vector<::std::u16string>* result, std::u16string_view word, std::u16string_view partOfSpeech) const
 {
+    ReadGuard dictionary(*this);
     if (result != nullptr) {
         result->clear();
     }
     auto exists = dictionary->getWordPropertyValues(result, word, partOfSpeech);
-    if (!exists && !inflection::util::StringViewUtils::isAllLowerCase(word) && !dictionary->getWordType(word)) {
+    if (!exists && dictionary->needsLowercaseRetry(word) && !dictionary->getWordType(word)) {
         ::std::u16string normalized;
         transform(&normalized, word, dictionary->getLocale());
         if (normalized != word) {
@@ -219,14 +638,94 @@ bool DictionaryMetaData::getPropertyValues(::std::vector<::std::u16string>* resu
     return exists;
 }
 
+bool DictionaryMetaData::getPropertyValues(::std::u16string* valuesBuffer, ::std::vector<::std::u16string_view>* result, std::u16string_view word, std::u16string_view partOfSpeech) const
+{
+    ReadGuard dictionary(*this);
+    npc(valuesBuffer)->clear();
+    npc(result)->clear();
+    auto exists = dictionary->getWordPropertyValues(valuesBuffer, result, word, partOfSpeech);
+    if (!exists && dictionary->needsLowercaseRetry(word) && !dictionary->getWordType(word)) {
+        ::std::u16string normalized;
+        transform(&normalized, word, dictionary->getLocale());
+        if (normalized != word) {
+            exists = dictionary->getWordPropertyValues(valuesBuffer, result, normalized, partOfSpeech);
+        }
+    }
+    return exists;
+}
+
+bool DictionaryMetaData::getPropertyValues(::std::string* valuesBuffer, ::std::vector<::std::string_view>* result, std::string_view word, std::u16string_view partOfSpeech) const
+{
+    ReadGuard dictionary(*this);
+    npc(valuesBuffer)->clear();
+    npc(result)->clear();
+    auto exists = dictionary->getWordPropertyValues(valuesBuffer, result, word, partOfSpeech);
+    if (!exists) {
+        // Lowercasing is locale sensitive, and it is done in UTF-16.
+        auto utf16Word(inflection::util::StringViewUtils::to_u16string(word));
+        if (dictionary->needsLowercaseRetry(utf16Word) && !dictionary->getWordType(word)) {
+            ::std::u16string normalized;
+            transform(&normalized, utf16Word, dictionary->getLocale());
+            if (normalized != utf16Word) {
+                exists = dictionary->getWordPropertyValues(valuesBuffer, result, inflection::util::StringViewUtils::to_string(normalized), partOfSpeech);
+            }
+        }
+    }
+    return exists;
+}
+
 DictionaryKeyIterator DictionaryMetaData::getKnownWords() const
 {
+    // The iterator references the dictionary, so it stays mapped after this returns.
+    ReadGuard dictionary(*this);
     return dictionary->getAllWords();
 }
 
+DictionaryKeyIterator DictionaryMetaData::getKnownWords(int32_t partition, int32_t partitionCount) const
+{
+    // The iterator references the dictionary, so it stays mapped after this returns.
+    ReadGuard dictionary(*this);
+    return dictionary->getAllWords(partition, partitionCount);
+}
+
 int32_t DictionaryMetaData::getKnownWordsSize() const
 {
+    ReadGuard dictionary(*this);
     return dictionary->getAllWordsSize();
 }
 
+void DictionaryMetaData::forEachKnownWordWithPrefix(std::u16string_view prefix, int64_t requiredProperties, const ::std::function<bool(std::u16string_view word)>& callback) const
+{
+    ReadGuard dictionary(*this);
+    dictionary->forEachWordWithPrefix(prefix, requiredProperties, callback);
+}
+
+void DictionaryMetaData::forEachKnownWordPrefixOf(std::u16string_view text, int64_t requiredProperties, const ::std::function<bool(std::u16string_view word)>& callback) const
+{
+    ReadGuard dictionary(*this);
+    dictionary->forEachWordPrefixOf(text, requiredProperties, callback);
+}
+
+bool DictionaryMetaData::getKnownWordsForLemma(::std::vector<::std::u16string>* result, std::u16string_view lemma) const
+{
+    ReadGuard dictionary(*this);
+    return dictionary->getWordsForLemma(result, lemma, -1);
+}
+
+void DictionaryMetaData::getMemoryUsage(::inflection::util::MemoryUsage* usage) const
+{
+    ReadGuard dictionary(*this);
+    dictionary->addMemoryUsage(usage);
+}
+
+void DictionaryMetaData::getCacheMemoryUsage(::inflection::util::MemoryUsage* usage)
+{
+    auto dictionaryCache = DICTIONARY_CACHE().load(::std::memory_order_acquire);
+    size_t heapBytes = ::inflection::util::MemoryUsage::estimateNodeHeapBytes(*npc(dictionaryCache));
+    for (const auto& [language, dictionary] : *dictionaryCache) {
+        heapBytes += language.capacity() + sizeof(DictionaryMetaData) + sizeof(Inflector) + sizeof(DictionaryMetaData_MMappedDictionary);
+    }
+    npc(usage)->addHeap("dictionary cache", heapBytes);
+}
+
 } // namespace inflection::dictionary
@@ -5,10 +5,15 @@
 
 #include <inflection/dictionary/fwd.hpp>
 #include <inflection/dictionary/DictionaryKeyIterator.hpp>
+#include <inflection/resources/fwd.hpp>
 #include <inflection/util/fwd.hpp>
 #include <inflection/Object.hpp>
+#include <atomic>
+#include <functional>
 #include <map>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 #include <string_view>
@@ -30,17 +35,43 @@ public:
      * Factory method to return a DictionaryMetaData singleton for each locale.
      * @param locale The locale to get the lexical dictionary.
      * @return A singleton. Do not delete this object.
+     * @see inflection::resources::DataRegistrationService::registerDictionaryForLocale() for replacing the dictionary
+     * behind the singleton.
      */
     static const DictionaryMetaData* createDictionary(const ::inflection::util::ULocale& locale);
+    /**
+     * Set how the pages of the dictionary for the language of the locale are brought into memory.
+     * When the dictionary is already loaded, the policy is applied to it immediately. Otherwise it is used when the
+     * dictionary is loaded. Languages without a policy use inflection::util::MemoryMappedFile::getDefaultResidencyPolicy().
+     * @param locale The locale of the dictionary.
+     * @param residencyPolicy The inflection::util::MemoryMappedFile::ResidencyPolicy bits.
+     */
+    static void setResidencyPolicy(const ::inflection::util::ULocale& locale, int32_t residencyPolicy);
 
 private:
     static ::std::u16string* transform(::std::u16string* dest, std::u16string_view str, const ::inflection::util::ULocale& locale);
+    /**
+     * Look up the lowercase form of a word that was not found as is.
+     */
+    static ::std::optional<int64_t> getLowercaseWordType(const DictionaryMetaData_MMappedDictionary& dictionary, std::u16string_view word);
 
 public:
     /**
      * Get all of the binary types of a word or phrase. The name for each bit can be retrieved by getPropertyName().
      */
     int64_t* getCombinedBinaryType(int64_t* result, std::u16string_view word) const;
+    /**
+     * Like getCombinedBinaryType, but the word is UTF-8. No conversion is done for exact matches when the dictionary
+     * has UTF-8 keys.
+     */
+    int64_t* getCombinedBinaryType(int64_t* result, std::string_view word) const;
+    /**
+     * Get the binary types of many words at once. This is faster than calling getCombinedBinaryType for each word
+     * because the conversion buffers are reused across the batch.
+     * @param results Each entry is set to the combined binary type of the word at the same index, or 0 when the word is unknown.
+     * @param words The words or phrases to look up. This must be the same size as results.
+     */
+    void getCombinedBinaryTypes(::std::span<int64_t> results, ::std::span<const ::std::u16string_view> words) const;
 
     /**
      * Turns all of the bits in the binary properties into string based property names.
@@ -54,6 +85,10 @@ public:
      * Is the provided word a known word in the dictionary.
      */
     bool isKnownWord(std::u16string_view word) const;
+    /**
+     * Is the provided UTF-8 word a known word in the dictionary.
+     */
+    bool isKnownWord(std::string_view word) const;
     /**
      * Does the given word or phrase have the specified property.
      * If you plan to do a lot of these operations, it's faster to turn the property name into a binary
@@ -81,6 +116,13 @@ public:
      * @return The binary value representing the requested properties.
      */
     int64_t getBinaryProperties(const ::std::vector<::std::u16string>& properties) const;
+    /**
+     * Convert each property name to its own binary value with a single access of the dictionary.
+     * This is faster than calling getBinaryProperties() for each property.
+     * @param result Set to the binary value of each property, in the same order as the properties. The value of an
+     * unknown property is 0.
+     */
+    void getBinaryPropertiesOfEach(::std::vector<int64_t>* result, const ::std::vector<::std::u16string>& properties) const;
     /**
      * Returns the string form of all of the binary property values.
      */
@@ -93,24 +135,152 @@ public:
      * Returns the all of the values for the given property key.
      */
     bool getPropertyValues(::std::vector<::std::u16string>* result, std::u16string_view word, std::u16string_view partOfSpeech) const;
+    /**
+     * Returns the all of the values for the given property key as views into valuesBuffer.
+     * Both valuesBuffer and result are cleared first. Reusing them between calls avoids allocating a new string for every value.
+     * The views remain valid until valuesBuffer is modified or destroyed.
+     */
+    bool getPropertyValues(::std::u16string* valuesBuffer, ::std::vector<::std::u16string_view>* result, std::u16string_view word, std::u16string_view partOfSpeech) const;
+    /**
+     * Like the UTF-16 version with a values buffer, but the word and the returned values are UTF-8.
+     * No conversion is done for exact matches when the dictionary has UTF-8 keys.
+     */
+    bool getPropertyValues(::std::string* valuesBuffer, ::std::vector<::std::string_view>* result, std::string_view word, std::u16string_view partOfSpeech) const;
     /**
      * Returns an iterator to iterate over all known words in this dictionary.
      */
     ::inflection::dictionary::DictionaryKeyIterator getKnownWords() const;
+    /**
+     * Returns an iterator over one of partitionCount disjoint parts of the known words. Together, the parts contain
+     * each known word exactly once, and the parts can be iterated concurrently from different threads.
+     * The words within a part are in a stable internal order instead of the order of getKnownWords(), and the same
+     * dictionary always has the same parts.
+     * @param partition The part to iterate, from 0 to partitionCount - 1.
+     * @param partitionCount The number of parts to split the words into.
+     * @throws IllegalArgumentException when the partition is not in [0, partitionCount).
+     */
+    ::inflection::dictionary::DictionaryKeyIterator getKnownWords(int32_t partition, int32_t partitionCount) const;
     /**
      * Returns the number of known words in this dictionary.
      */
     int32_t getKnownWordsSize() const;
+    /**
+     * Call the callback with each known word that starts with the prefix, like an autocompletion.
+     * The words are in the same order as getKnownWords(), and they are matched exactly as they are in the dictionary.
+     * The view of the word is only valid during the callback, and no string is allocated for each word.
+     * Iteration stops when the callback returns false.
+     * The dictionary is in use until this returns, so the callback must not replace it, and the callback must not load
+     * other data when a memory budget is set.
+     * @param prefix The start of the words. An empty prefix reports all of the known words.
+     * @param requiredProperties Only words that have all of these binary properties from getBinaryProperties() are
+     * reported. Zero reports all of the words.
+     * @param callback Returns true to continue with the next word.
+     */
+    void forEachKnownWordWithPrefix(std::u16string_view prefix, int64_t requiredProperties, const ::std::function<bool(std::u16string_view word)>& callback) const;
+    /**
+     * Call the callback with each known word that is a prefix of the text, from the shortest word to the longest.
+     * The words are matched exactly as they are in the dictionary.
+     * The view of the word is only valid during the callback, and no string is allocated for each word.
+     * Iteration stops when the callback returns false.
+     * The dictionary is in use until this returns, so the callback must not replace it, and the callback must not load
+     * other data when a memory budget is set.
+     * @param text The text that the words are a prefix of.
+     * @param requiredProperties Only words that have all of these binary properties from getBinaryProperties() are
+     * reported. Zero reports all of the words.
+     * @param callback Returns true to continue with the next word.
+     */
+    void forEachKnownWordPrefixOf(std::u16string_view text, int64_t requiredProperties, const ::std::function<bool(std::u16string_view word)>& callback) const;
+    /**
+     * Get the known words that inflect from the lemma with any inflection pattern. The lemma is matched exactly.
+     * The time taken is proportional to the number of words of the lemma, and not the dictionary size.
+     * @param result The words are appended to this vector.
+     * @return false when the dictionary was built without a lemma index.
+     */
+    bool getKnownWordsForLemma(::std::vector<::std::u16string>* result, std::u16string_view lemma) const;
+    /**
+     * Add the mapped, resident and heap memory of each section of this dictionary, including its inflection table.
+     */
+    void getMemoryUsage(::inflection::util::MemoryUsage* usage) const;
+    /**
+     * Add the estimated heap memory of the dictionary cache used by createDictionary.
+     * The memory of the dictionaries themselves are reported by getMemoryUsage.
+     */
+    static void getCacheMemoryUsage(::inflection::util::MemoryUsage* usage);
 
 private:
-    explicit DictionaryMetaData(DictionaryMetaData_MMappedDictionary* dictionary);
+    DictionaryMetaData(const ::inflection::util::ULocale& locale, DictionaryMetaData_MMappedDictionary* dictionary);
     DictionaryMetaData(const DictionaryMetaData& other) = delete;
     DictionaryMetaData& operator=(const DictionaryMetaData& other) = delete;
     ~DictionaryMetaData() override;
 
+    /**
+     * Replace the dictionary of the language of the locale with the dictionary file at the path.
+     * @throws IOException when the file can not be read.
+     * @throws IllegalArgumentException when the file is for a different language.
+     */
+    static void replaceDictionary(const ::inflection::util::ULocale& locale, const ::std::u16string& path);
+    /**
+     * Publish the replacement, and wait until no reader can still see the previous dictionary.
+     * The previous dictionary is then deleted, unless an inflection pattern or a key iterator still references it.
+     * In that case it is retired, and it is deleted by a later swap after its last reference is deleted.
+     * A null replacement evicts the dictionary.
+     * The caller must hold the swap mutex, which serializes the swaps, and must not hold the class mutex. A reader
+     * that finds the dictionary evicted takes the class mutex to reload it, so waiting for the readers while holding the
+     * class mutex could deadlock.
+     * @return the resident and heap memory of the dictionaries that were deleted.
+     */
+    int64_t swapDictionary(DictionaryMetaData_MMappedDictionary* replacement);
+    /**
+     * Load the dictionary again after it was evicted.
+     */
+    void reloadDictionary() const;
+
+    struct LoadedDictionary {
+        int64_t lastUsed;
+        ::std::string language;
+        /** The resident and heap memory of the dictionary, and of the replaced dictionaries that are still referenced. */
+        int64_t bytes;
+    };
+    /**
+     * Get the dictionaries that are currently mapped, including the retired ones. A larger lastUsed was used more recently.
+     */
+    static void getLoadedDictionaries(::std::vector<LoadedDictionary>* result);
+    /**
+     * Unmap the dictionary of the language until it is used again. A dictionary that is still referenced is unmapped
+     * by a later eviction instead.
+     * @return the resident and heap memory that was released.
+     */
+    static int64_t evictDictionary(::std::string_view language);
+    /**
+     * Delete the replaced dictionaries that are no longer referenced. Only called while holding the swap mutex.
+     * @return the resident and heap memory that was released.
+     */
+    int64_t releaseRetiredDictionaries();
+
 private:
-    std::unique_ptr<DictionaryMetaData_MMappedDictionary> dictionary;
+    class ReadGuard;
+
+    const ::std::string localeName;
+    /**
+     * Readers only take a snapshot of this pointer while their thread is marked as reading by a ReadGuard.
+     * This makes it possible to swap the dictionary without a lock on the lookup path.
+     */
+    mutable ::std::atomic<DictionaryMetaData_MMappedDictionary*> currentDictionary;
+    mutable ::std::atomic<int64_t> lastUsed { 0 };
+    ::std::u16string replacementPath {  };
+    /**
+     * The replaced dictionaries that are still referenced by inflection patterns or key iterators. This is guarded by
+     * the swap mutex.
+     */
+    ::std::vector<::std::unique_ptr<DictionaryMetaData_MMappedDictionary>> retiredDictionaries {  };
+    /**
+     * Looks up the inflection patterns in whichever dictionary is current, so it stays valid when the dictionary is
+     * replaced or evicted.
+     */
+    ::std::unique_ptr<Inflector> inflector;
 private:
     friend class Inflector;
     friend class Inflector_MMappedDictionary;
+    friend class ::inflection::resources::DataRegistrationService;
+    friend class ::inflection::resources::MemoryBudget;
 };
@@ -4,13 +4,19 @@
 #include <inflection/dictionary/DictionaryMetaData_MMappedDictionary.hpp>
 
 #include <inflection/dictionary/DictionaryKeyIterator.hpp>
-#include <inflection/dictionary/Inflector.hpp>
+#include <inflection/dictionary/Inflector_MMappedDictionary.hpp>
 #include <inflection/util/MemoryMappedFile.hpp>
+#include <inflection/util/MemoryUsage.hpp>
+#include <inflection/util/ShardedCounter_Reference.hpp>
+#include <inflection/util/StringViewUtils.hpp>
+#include <inflection/exception/IllegalArgumentException.hpp>
 #include <inflection/exception/IncompatibleVersionException.hpp>
 #include <inflection/exception/IOException.hpp>
 #include <inflection/npc.hpp>
 #include <string>
 #include <memory>
+#include <unicode/uchar.h>
+#include <unicode/utf16.h>
 
 namespace inflection::dictionary {
 
@@ -34,13 +40,18 @@ DictionaryMetaData_MMappedDictionary::DictionaryMetaData_MMappedDictionary(::inf
     , propertyNameToKeyId(memoryMappedRegion)
     , propertyValuesStringContainer(memoryMappedRegion)
     , propertyValueMaps(memoryMappedRegion)
-    , inflector((options & (int16_t)OptionBits::HAS_INFLECTION_TABLE) != 0 ? new Inflector(*npc(memoryMappedRegion), sourcePath, *this) : nullptr)
+    , inflectorDictionary((options & (int16_t)OptionBits::HAS_INFLECTION_TABLE) != 0 ? new Inflector_MMappedDictionary(*npc(memoryMappedRegion), sourcePath, *this) : nullptr)
+    , caseFoldedWordsToDataTrie((options & (int16_t)OptionBits::HAS_CASE_FOLDED_WORDS) != 0 ? new ::inflection::dictionary::metadata::MarisaTrie<uint64_t>(memoryMappedRegion) : nullptr)
+    , membershipFilter((options & (int16_t)OptionBits::HAS_MEMBERSHIP_FILTER) != 0 ? new ::inflection::dictionary::metadata::MembershipFilter(memoryMappedRegion) : nullptr)
+    , lemmaToWordsTrie((options & (int16_t)OptionBits::HAS_LEMMA_INDEX) != 0 ? new ::inflection::dictionary::metadata::MarisaTrie<int32_t>(memoryMappedRegion) : nullptr)
+    , lemmaToWordsEntries((options & (int16_t)OptionBits::HAS_LEMMA_INDEX) != 0 ? new ::inflection::dictionary::metadata::CompressedArray<int32_t>(memoryMappedRegion) : nullptr)
     , memoryMappedRegion(memoryMappedRegion)
     , inflectionKeyIdentifier(propertyNameToKeyId.getIdentifierIfAvailable(inflection::dictionary::Inflector_MMappedDictionary::INFLECTION_KEY))
     , bitsPropertyValueMapKeyMask((int32_t(1) << bitsPropertyValueMapKey) - 1)
     , bitsPropertyValueMapKeySize(inflection::dictionary::metadata::CompressedArray<int32_t>::calculateBitWidth(propertyNameToKeyId.size()))
     , isDoubleStageLookup(!wordsToDataSingletons.isEmpty())
 {
+    buildTypeIdentifierHashTable();
 }
 
 DictionaryMetaData_MMappedDictionary::~DictionaryMetaData_MMappedDictionary() = default;
@@ -50,9 +61,90 @@ const ::inflection::util::ULocale& DictionaryMetaData_MMappedDictionary::getLoca
     return locale;
 }
 
-std::optional<int64_t> DictionaryMetaData_MMappedDictionary::getWordType(std::u16string_view word) const
+std::optional<uint64_t> DictionaryMetaData_MMappedDictionary::findWordData(std::u16string_view word) const
 {
+    if (membershipFilter && !membershipFilter->mightContain(word)) {
+        return {};
+    }
     auto result(wordsToDataTrie.find(word));
+    if (!result && caseFoldedWordsToDataTrie) {
+        result = caseFoldedWordsToDataTrie->find(word);
+    }
+    return result;
+}
+
+std::optional<uint64_t> DictionaryMetaData_MMappedDictionary::findWordData(std::u16string_view word, ::std::string* encodedBuffer) const
+{
+    if (membershipFilter && !membershipFilter->mightContain(word)) {
+        return {};
+    }
+    auto result(wordsToDataTrie.find(word, encodedBuffer));
+    if (!result && caseFoldedWordsToDataTrie) {
+        result = caseFoldedWordsToDataTrie->find(word, encodedBuffer);
+    }
+    return result;
+}
+
+std::optional<uint64_t> DictionaryMetaData_MMappedDictionary::findWordData(std::string_view word) const
+{
+    if (membershipFilter && !membershipFilter->mightContain(word)) {
+        return {};
+    }
+    auto result(wordsToDataTrie.find(word));
+    if (!result && caseFoldedWordsToDataTrie) {
+        result = caseFoldedWordsToDataTrie->find(word);
+    }
+    return result;
+}
+
+/**
+ * Returns true when the first character is not lowercase, and the rest of the word is all lowercase or all uppercase.
+ * Characters without case are both.
+ */
+static bool isTitleCaseOrUpperCase(std::u16string_view word)
+{
+    auto size = static_cast<int32_t>(word.length());
+    int32_t idx = 0;
+    UChar32 cp;
+    U16_NEXT(word.data(), idx, size, cp);
+    if (cp == u_tolower(cp)) {
+        return false;
+    }
+    bool hasLowerCase = false;
+    bool hasUpperCase = false;
+    while (idx < size) {
+        U16_NEXT(word.data(), idx, size, cp);
+        hasUpperCase |= cp != u_tolower(cp);
+        hasLowerCase |= cp != u_toupper(cp);
+    }
+    return !(hasLowerCase && hasUpperCase);
+}
+
+bool DictionaryMetaData_MMappedDictionary::needsLowercaseRetry(std::u16string_view word) const
+{
+    if (word.empty() || ::inflection::util::StringViewUtils::isAllLowerCase(word)) {
+        return false;
+    }
+    return caseFoldedWordsToDataTrie == nullptr || !isTitleCaseOrUpperCase(word);
+}
+
+std::optional<int64_t> DictionaryMetaData_MMappedDictionary::getWordType(std::u16string_view word) const
+{
+    return getWordTypeFromData(findWordData(word));
+}
+
+std::optional<int64_t> DictionaryMetaData_MMappedDictionary::getWordType(std::string_view word) const
+{
+    return getWordTypeFromData(findWordData(word));
+}
+
+std::optional<int64_t> DictionaryMetaData_MMappedDictionary::getWordType(std::u16string_view word, ::std::string* encodedBuffer) const
+{
+    return getWordTypeFromData(findWordData(word, encodedBuffer));
+}
+
+std::optional<int64_t> DictionaryMetaData_MMappedDictionary::getWordTypeFromData(const std::optional<uint64_t>& result) const
+{
     if (result) {
         uint64_t dataSingleton = *result;
         if (isDoubleStageLookup) {
@@ -66,12 +158,35 @@ std::optional<int64_t> DictionaryMetaData_MMappedDictionary::getWordType(std::u1
     return {};
 }
 
+void DictionaryMetaData_MMappedDictionary::buildTypeIdentifierHashTable()
+{
+    // Keep the table at most half full, so that a probe sequence stays short.
+    size_t tableSize = 2;
+    while (tableSize < size_t(typesStringContainer.size()) * 2) {
+        tableSize <<= 1;
+    }
+    typeIdentifierHashTable.assign(tableSize, -1);
+    const auto mask = tableSize - 1;
+    for (int32_t id = 0; id < typesStringContainer.size(); id++) {
+        auto slot = ::std::hash<std::u16string_view>()(typesStringContainer.getStringView(id)) & mask;
+        while (typeIdentifierHashTable[slot] >= 0) {
+            slot = (slot + 1) & mask;
+        }
+        typeIdentifierHashTable[slot] = id;
+    }
+}
+
 std::optional<int64_t> DictionaryMetaData_MMappedDictionary::getValueOfType(std::u16string_view type) const
 {
-    // An exception is thrown if the type is invalid.
-    auto id = typesStringContainer.getIdentifierIfAvailable(type);
-    if (id >= 0) {
-        return inflection::dictionary::metadata::StringContainer::convertIdentifierToBit(id);
+    if (typeIdentifierHashTable.empty()) {
+        return {};
+    }
+    const auto mask = typeIdentifierHashTable.size() - 1;
+    for (auto slot = ::std::hash<std::u16string_view>()(type) & mask; typeIdentifierHashTable[slot] >= 0; slot = (slot + 1) & mask) {
+        auto id = typeIdentifierHashTable[slot];
+        if (typesStringContainer.getStringView(id) == type) {
+            return inflection::dictionary::metadata::StringContainer::convertIdentifierToBit(id);
+        }
     }
     return {};
 }
@@ -89,6 +204,14 @@ int64_t DictionaryMetaData_MMappedDictionary::getValuesOfTypes(const std::vector
     return result;
 }
 
+void DictionaryMetaData_MMappedDictionary::getValueOfEachType(::std::vector<int64_t>* result, const std::vector<std::u16string> &types) const
+{
+    npc(result)->resize(types.size());
+    for (size_t idx = 0; idx < types.size(); idx++) {
+        (*result)[idx] = getValueOfType(types[idx]).value_or(0);
+    }
+}
+
 std::optional<::std::u16string> DictionaryMetaData_MMappedDictionary::getTypeOfValue(int64_t value) const
 {
     auto id = inflection::dictionary::metadata::StringContainer::convertBitToIdentifier(value);
@@ -113,7 +236,19 @@ std::vector<::std::u16string> DictionaryMetaData_MMappedDictionary::getTypesOfVa
 
 DictionaryKeyIterator DictionaryMetaData_MMappedDictionary::getAllWords() const
 {
-    return DictionaryKeyIterator(wordsToDataTrie.getAllWithPrefix(u""));
+    return DictionaryKeyIterator(wordsToDataTrie.getAllWithPrefix(u""), new ::inflection::util::ShardedCounter_Reference(references));
+}
+
+DictionaryKeyIterator DictionaryMetaData_MMappedDictionary::getAllWords(int32_t partition, int32_t partitionCount) const
+{
+    if (partitionCount <= 0 || partition < 0 || partition >= partitionCount) {
+        throw ::inflection::exception::IllegalArgumentException(u"partition must be in the range [0, partitionCount)");
+    }
+    // Split the key ids evenly, so that the parts are the same every time for the same dictionary.
+    int64_t size = wordsToDataTrie.getSize();
+    auto beginId = int32_t(size * partition / partitionCount);
+    auto endId = int32_t(size * (partition + 1) / partitionCount);
+    return DictionaryKeyIterator(wordsToDataTrie.getAllInKeyIdRange(beginId, endId), new ::inflection::util::ShardedCounter_Reference(references));
 }
 
 int32_t DictionaryMetaData_MMappedDictionary::getAllWordsSize() const
@@ -121,24 +256,49 @@ int32_t DictionaryMetaData_MMappedDictionary::getAllWordsSize() const
     return wordsToDataTrie.getSize();
 }
 
+void DictionaryMetaData_MMappedDictionary::forEachWordWithPrefix(std::u16string_view prefix, int64_t requiredTypes, const ::std::function<bool(std::u16string_view)>& callback) const
+{
+    ::std::u16string keyBuffer;
+    wordsToDataTrie.forEachWithPrefix(prefix, &keyBuffer, [this, requiredTypes, &callback](std::u16string_view word, uint64_t data) {
+        if (requiredTypes != 0) {
+            auto wordType = getWordTypeFromData(data);
+            if (!wordType || (*wordType & requiredTypes) != requiredTypes) {
+                return true;
+            }
+        }
+        return callback(word);
+    });
+}
+
+void DictionaryMetaData_MMappedDictionary::forEachWordPrefixOf(std::u16string_view text, int64_t requiredTypes, const ::std::function<bool(std::u16string_view)>& callback) const
+{
+    ::std::u16string keyBuffer;
+    wordsToDataTrie.forEachPrefixOf(text, &keyBuffer, [this, requiredTypes, &callback](std::u16string_view word, uint64_t data) {
+        if (requiredTypes != 0) {
+            auto wordType = getWordTypeFromData(data);
+            if (!wordType || (*wordType & requiredTypes) != requiredTypes) {
+                return true;
+            }
+        }
+        return callback(word);
+    });
+}
+
 void DictionaryMetaData_MMappedDictionary::getPropertyMapInternalIdentifiers(std::vector<int32_t> &propertyIdentifiers, int32_t startingOffset, int32_t length) const
 {
-    propertyIdentifiers.reserve(length);
-    for (int32_t idx = 0; idx < length; idx++) {
-        propertyIdentifiers.emplace_back(propertyValueMaps.read(startingOffset + idx));
-    }
+    const auto existingSize = propertyIdentifiers.size();
+    propertyIdentifiers.resize(existingSize + length);
+    propertyValueMaps.readRange(propertyIdentifiers.data() + existingSize, startingOffset, length);
 }
 
-DictionaryMetaData_MMappedDictionary::ListResultEnum DictionaryMetaData_MMappedDictionary::getWordPropertyInternalIdentifiers(std::vector<int32_t> &propertyIdentifiers, std::u16string_view word, int32_t propertyNameIdentifier) const {
+DictionaryMetaData_MMappedDictionary::ListResultEnum DictionaryMetaData_MMappedDictionary::getWordPropertyValuesRange(int32_t* valuesOffset, int32_t* valuesLength, const std::optional<uint64_t>& trieResult, int32_t propertyNameIdentifier) const {
     if (propertyNameIdentifier < 0) {
         return UNKNOWN;
     }
 
-    auto trieResult(wordsToDataTrie.find(word));
     if (!trieResult) {
         return UNKNOWN;
     }
-    propertyIdentifiers.clear();
     uint64_t dataSingleton = *trieResult;
     if (isDoubleStageLookup) {
         dataSingleton = wordsToDataSingletons.read((int32_t) dataSingleton);
@@ -157,7 +317,8 @@ DictionaryMetaData_MMappedDictionary::ListResultEnum DictionaryMetaData_MMappedD
             }
             int32_t valuesSegmentSize = keyEntry >> bitsPropertyValueMapKey;
             if (key == propertyNameIdentifier) {
-                getPropertyMapInternalIdentifiers(propertyIdentifiers, offset + originalMapSize + cumulativeOffset, valuesSegmentSize);
+                *npc(valuesOffset) = offset + originalMapSize + cumulativeOffset;
+                *npc(valuesLength) = valuesSegmentSize;
                 return VALUES;
             }
             cumulativeOffset += valuesSegmentSize;
@@ -166,6 +327,27 @@ DictionaryMetaData_MMappedDictionary::ListResultEnum DictionaryMetaData_MMappedD
     return EMPTY;
 }
 
+DictionaryMetaData_MMappedDictionary::ListResultEnum DictionaryMetaData_MMappedDictionary::getWordPropertyInternalIdentifiers(std::vector<int32_t> &propertyIdentifiers, const std::optional<uint64_t>& trieResult, int32_t propertyNameIdentifier) const {
+    int32_t valuesOffset = 0;
+    int32_t valuesLength = 0;
+    auto result = getWordPropertyValuesRange(&valuesOffset, &valuesLength, trieResult, propertyNameIdentifier);
+    if (result != UNKNOWN) {
+        propertyIdentifiers.clear();
+    }
+    if (result == VALUES) {
+        getPropertyMapInternalIdentifiers(propertyIdentifiers, valuesOffset, valuesLength);
+    }
+    return result;
+}
+
+DictionaryMetaData_MMappedDictionary::ListResultEnum DictionaryMetaData_MMappedDictionary::getWordPropertyInternalIdentifiers(std::vector<int32_t> &propertyIdentifiers, std::u16string_view word, int32_t propertyNameIdentifier) const {
+    return getWordPropertyInternalIdentifiers(propertyIdentifiers, findWordData(word), propertyNameIdentifier);
+}
+
+DictionaryMetaData_MMappedDictionary::ListResultEnum DictionaryMetaData_MMappedDictionary::getWordPropertyInternalIdentifiers(std::vector<int32_t> &propertyIdentifiers, std::string_view word, int32_t propertyNameIdentifier) const {
+    return getWordPropertyInternalIdentifiers(propertyIdentifiers, findWordData(word), propertyNameIdentifier);
+}
+
 bool DictionaryMetaData_MMappedDictionary::getWordPropertyValues(::std::vector<::std::u16string>* result, std::u16string_view word, std::u16string_view property) const
 {
     const auto propertyNameIdentifier = propertyNameToKeyId.getIdentifier(property);
@@ -185,21 +367,145 @@ bool DictionaryMetaData_MMappedDictionary::getWordPropertyValues(::std::vector<:
         return true;
     }
 
-    const bool useInflectionTrieForKeys = (inflector.get() != nullptr) && (propertyNameIdentifier == inflectionKeyIdentifier);
+    const bool useInflectionTrieForKeys = (inflectorDictionary.get() != nullptr) && (propertyNameIdentifier == inflectionKeyIdentifier);
 
+    ::std::u16string buffer;
     for (const auto propertyIdentifier: propertyIdentifiers) {
-        npc(result)->emplace_back(useInflectionTrieForKeys
-                ? inflector->mmappedDictionary.identifierToInflectionPatternTrie.getKey(propertyIdentifier)
-                : propertyValuesStringContainer.getString(propertyIdentifier));
+        if (useInflectionTrieForKeys) {
+            npc(result)->emplace_back(inflectorDictionary->getInflectionPatternIdentifier(&buffer, propertyIdentifier));
+        }
+        else {
+            npc(result)->emplace_back(propertyValuesStringContainer.getString(propertyIdentifier));
+        }
+    }
+
+    return true;
+}
+
+template <typename CharT>
+void DictionaryMetaData_MMappedDictionary::getPropertyValuesFromRange(::std::basic_string<CharT>* valuesBuffer, ::std::vector<::std::basic_string_view<CharT>>* result, int32_t valuesOffset, int32_t valuesLength, int32_t propertyNameIdentifier) const
+{
+    const bool useInflectionTrieForKeys = (inflectorDictionary.get() != nullptr) && (propertyNameIdentifier == inflectionKeyIdentifier);
+
+    // Each value is null terminated in the buffer. The views are created afterwards because appending can move the buffer.
+    npc(valuesBuffer)->clear();
+    npc(result)->clear();
+    for (int32_t idx = 0; idx < valuesLength; idx++) {
+        auto propertyIdentifier = propertyValueMaps.read(valuesOffset + idx);
+        if (useInflectionTrieForKeys) {
+            inflectorDictionary->appendInflectionPatternIdentifier(valuesBuffer, propertyIdentifier);
+        }
+        else {
+            propertyValuesStringContainer.appendString(valuesBuffer, propertyIdentifier);
+        }
+        valuesBuffer->push_back(CharT(0));
     }
+    ::std::basic_string_view<CharT> remaining(*valuesBuffer);
+    while (!remaining.empty()) {
+        auto valueLength = remaining.find(CharT(0));
+        result->emplace_back(remaining.substr(0, valueLength));
+        remaining.remove_prefix(valueLength + 1);
+    }
+}
 
+bool DictionaryMetaData_MMappedDictionary::getWordPropertyValues(::std::u16string* valuesBuffer, ::std::vector<::std::u16string_view>* result, std::u16string_view word, std::u16string_view property) const
+{
+    const auto propertyNameIdentifier = propertyNameToKeyId.getIdentifier(property);
+    int32_t valuesOffset = 0;
+    int32_t valuesLength = 0;
+    if (getWordPropertyValuesRange(&valuesOffset, &valuesLength, findWordData(word), propertyNameIdentifier) != VALUES) {
+        return false;
+    }
+    getPropertyValuesFromRange(valuesBuffer, result, valuesOffset, valuesLength, propertyNameIdentifier);
     return true;
 }
 
+bool DictionaryMetaData_MMappedDictionary::getWordPropertyValues(::std::string* valuesBuffer, ::std::vector<::std::string_view>* result, std::string_view word, std::u16string_view property) const
+{
+    const auto propertyNameIdentifier = propertyNameToKeyId.getIdentifier(property);
+    int32_t valuesOffset = 0;
+    int32_t valuesLength = 0;
+    if (getWordPropertyValuesRange(&valuesOffset, &valuesLength, findWordData(word), propertyNameIdentifier) != VALUES) {
+        return false;
+    }
+    getPropertyValuesFromRange(valuesBuffer, result, valuesOffset, valuesLength, propertyNameIdentifier);
+    return true;
+}
+
+void DictionaryMetaData_MMappedDictionary::applyResidencyPolicy(int32_t residencyPolicy) const
+{
+    if (memoryMappedRegion) {
+        memoryMappedRegion->applyResidencyPolicy(residencyPolicy);
+    }
+}
+
+void DictionaryMetaData_MMappedDictionary::releaseResidentPages() const
+{
+    if (memoryMappedRegion) {
+        memoryMappedRegion->releaseResidentPages();
+    }
+}
+
+bool DictionaryMetaData_MMappedDictionary::getWordsForLemma(::std::vector<::std::u16string>* result, std::u16string_view lemma, int32_t inflectionPatternId) const
+{
+    if (!lemmaToWordsTrie) {
+        return false;
+    }
+    auto offset = lemmaToWordsTrie->find(lemma);
+    if (!offset) {
+        return true;
+    }
+    auto count = lemmaToWordsEntries->read(*offset);
+    ::std::vector<int32_t> entries(count * 2);
+    lemmaToWordsEntries->readRange(entries.data(), *offset + 1, count * 2);
+    for (int32_t idx = 0; idx < count * 2; idx += 2) {
+        if (inflectionPatternId < 0 || entries[idx] == inflectionPatternId) {
+            wordsToDataTrie.getKey(&npc(result)->emplace_back(), entries[idx + 1]);
+        }
+        else if (entries[idx] > inflectionPatternId) {
+            // The entries are sorted by the inflection pattern.
+            break;
+        }
+    }
+    return true;
+}
+
+void DictionaryMetaData_MMappedDictionary::addMemoryUsage(::inflection::util::MemoryUsage* usage) const
+{
+    typesStringContainer.addMemoryUsage(usage, "types");
+    npc(usage)->addHeap("type hash table", typeIdentifierHashTable.capacity() * sizeof(typeIdentifierHashTable[0]));
+    wordsToDataTrie.addMemoryUsage(usage, "words");
+    if (wordsToTypesSingletons != nullptr) {
+        npc(usage)->addMapped("word type singletons", wordsToTypesSingletons, wordsToTypesSingletonsSize * sizeof(wordsToTypesSingletons[0]));
+    }
+    wordsToDataSingletons.addMemoryUsage(usage, "word data singletons");
+    propertyNameToKeyId.addMemoryUsage(usage, "property names");
+    propertyValuesStringContainer.addMemoryUsage(usage, "property values");
+    propertyValueMaps.addMemoryUsage(usage, "property value maps");
+    if (inflectorDictionary) {
+        inflectorDictionary->addMemoryUsage(usage);
+    }
+    if (caseFoldedWordsToDataTrie) {
+        caseFoldedWordsToDataTrie->addMemoryUsage(usage, "case folded words");
+    }
+    if (membershipFilter) {
+        membershipFilter->addMemoryUsage(usage, "word membership filter");
+    }
+    if (lemmaToWordsTrie) {
+        lemmaToWordsTrie->addMemoryUsage(usage, "lemmas");
+        lemmaToWordsEntries->addMemoryUsage(usage, "lemma words");
+    }
+}
+
 DictionaryMetaData_MMappedDictionary* DictionaryMetaData_MMappedDictionary::createDictionary(const ::std::u16string& sourcePath)
+{
+    return createDictionary(sourcePath, ::inflection::util::MemoryMappedFile::getDefaultResidencyPolicy());
+}
+
+DictionaryMetaData_MMappedDictionary* DictionaryMetaData_MMappedDictionary::createDictionary(const ::std::u16string& sourcePath, int32_t residencyPolicy)
 {
     // RAII exception handling
-    ::std::unique_ptr<::inflection::util::MemoryMappedFile> mappedFile(new ::inflection::util::MemoryMappedFile(sourcePath));
+    ::std::unique_ptr<::inflection::util::MemoryMappedFile> mappedFile(new ::inflection::util::MemoryMappedFile(sourcePath, residencyPolicy));
     auto mappedRegion = mappedFile.get();
 
     if (mappedRegion->getSize() < sizeof(MAGIC_MARKER) + sizeof(VERSION) + sizeof(ENDIANNESS_MARKER)) {
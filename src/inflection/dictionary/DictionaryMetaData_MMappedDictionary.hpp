@@ -8,10 +8,14 @@
 #include <inflection/dictionary/metadata/fwd.hpp>
 #include <inflection/dictionary/metadata/CompressedArray.hpp>
 #include <inflection/dictionary/metadata/MarisaTrie.hpp>
+#include <inflection/dictionary/metadata/MembershipFilter.hpp>
 #include <inflection/dictionary/metadata/StringContainer.hpp>
 #include <inflection/dictionary/metadata/StringArrayContainer.hpp>
+#include <inflection/util/ShardedCounter.hpp>
 #include <inflection/util/ULocale.hpp>
 #include <inflection/Object.hpp>
+#include <atomic>
+#include <functional>
 #include <map>
 #include <optional>
 #include <string_view>
@@ -24,24 +28,80 @@ public:
     typedef ::inflection::Object super;
 
     static DictionaryMetaData_MMappedDictionary* createDictionary(const ::std::u16string& sourcePath);
+    /**
+     * @param residencyPolicy The MemoryMappedFile::ResidencyPolicy bits to use for the mapped file.
+     */
+    static DictionaryMetaData_MMappedDictionary* createDictionary(const ::std::u16string& sourcePath, int32_t residencyPolicy);
+    void applyResidencyPolicy(int32_t residencyPolicy) const;
+    void releaseResidentPages() const;
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage) const;
     const ::inflection::util::ULocale& getLocale() const;
     ::std::optional<int64_t> getWordType(std::u16string_view word) const;
+    ::std::optional<int64_t> getWordType(std::string_view word) const;
+    /**
+     * Like getWordType, but encodedBuffer is reused for encoding the word.
+     */
+    ::std::optional<int64_t> getWordType(std::u16string_view word, ::std::string* encodedBuffer) const;
     ::std::optional<int64_t> getValueOfType(std::u16string_view type) const;
     int64_t getValuesOfTypes(const std::vector<std::u16string> &types) const;
+    /**
+     * Set each value of the result to the value of the type at the same position. Unknown types have a value of 0.
+     */
+    void getValueOfEachType(::std::vector<int64_t>* result, const std::vector<std::u16string> &types) const;
     ::std::optional<::std::u16string> getTypeOfValue(int64_t value) const;
     ::std::vector<::std::u16string> getTypesOfValues(int64_t value) const;
 private:
+    void buildTypeIdentifierHashTable();
     void getPropertyMapInternalIdentifiers(std::vector<int32_t> &propertyIdentifiers, int32_t startingOffset, int32_t length) const;
     typedef enum {
         UNKNOWN = 0,
         EMPTY = 1,
         VALUES = 2,
     } ListResultEnum;
+    /**
+     * Find the data of the word, including the case variants in the case folded section.
+     */
+    ::std::optional<uint64_t> findWordData(std::u16string_view word) const;
+    ::std::optional<uint64_t> findWordData(std::u16string_view word, ::std::string* encodedBuffer) const;
+    ::std::optional<uint64_t> findWordData(std::string_view word) const;
+    /**
+     * Returns true when a word that was not found could still be found by lowercasing it. The case folded section
+     * already has the title case and uppercase forms of the lowercase words, so only other mixed case words are retried
+     * when it is present.
+     */
+    bool needsLowercaseRetry(std::u16string_view word) const;
+    ::std::optional<int64_t> getWordTypeFromData(const std::optional<uint64_t>& trieResult) const;
+    ListResultEnum getWordPropertyValuesRange(int32_t* valuesOffset, int32_t* valuesLength, const std::optional<uint64_t>& trieResult, int32_t propertyNameIdentifier) const;
+    ListResultEnum getWordPropertyInternalIdentifiers(std::vector<int32_t> &propertyIdentifiers, const std::optional<uint64_t>& trieResult, int32_t propertyNameIdentifier) const;
     ListResultEnum getWordPropertyInternalIdentifiers(std::vector<int32_t> &propertyIdentifiers, std::u16string_view word, int32_t propertyNameIdentifier) const;
+    ListResultEnum getWordPropertyInternalIdentifiers(std::vector<int32_t> &propertyIdentifiers, std::string_view word, int32_t propertyNameIdentifier) const;
+    template <typename CharT>
+    void getPropertyValuesFromRange(::std::basic_string<CharT>* valuesBuffer, ::std::vector<::std::basic_string_view<CharT>>* result, int32_t valuesOffset, int32_t valuesLength, int32_t propertyNameIdentifier) const;
 public:
     bool getWordPropertyValues(::std::vector<::std::u16string>* result, std::u16string_view word, std::u16string_view property) const;
+    bool getWordPropertyValues(::std::u16string* valuesBuffer, ::std::vector<::std::u16string_view>* result, std::u16string_view word, std::u16string_view property) const;
+    bool getWordPropertyValues(::std::string* valuesBuffer, ::std::vector<::std::string_view>* result, std::string_view word, std::u16string_view property) const;
     ::inflection::dictionary::DictionaryKeyIterator getAllWords() const;
+    /**
+     * Iterate over one of partitionCount disjoint parts of the words, in key id order.
+     * @throws IllegalArgumentException when the partition is not in [0, partitionCount).
+     */
+    ::inflection::dictionary::DictionaryKeyIterator getAllWords(int32_t partition, int32_t partitionCount) const;
     int32_t getAllWordsSize() const;
+    /**
+     * @param requiredTypes Only the words that have all of these types are reported. Zero reports all words.
+     */
+    void forEachWordWithPrefix(std::u16string_view prefix, int64_t requiredTypes, const ::std::function<bool(std::u16string_view)>& callback) const;
+    /**
+     * @param requiredTypes Only the words that have all of these types are reported. Zero reports all words.
+     */
+    void forEachWordPrefixOf(std::u16string_view text, int64_t requiredTypes, const ::std::function<bool(std::u16string_view)>& callback) const;
+    /**
+     * Append the words that inflect from the lemma to the result.
+     * @param inflectionPatternId Only the words that use this inflection pattern are reported. A negative value reports all words.
+     * @return false when this dictionary has no lemma index.
+     */
+    bool getWordsForLemma(::std::vector<::std::u16string>* result, std::u16string_view lemma, int32_t inflectionPatternId) const;
     explicit DictionaryMetaData_MMappedDictionary(::inflection::util::MemoryMappedFile* memoryMappedRegion, const ::std::u16string& sourcePath);
     explicit DictionaryMetaData_MMappedDictionary(const inflection::util::ULocale& locale);
     ~DictionaryMetaData_MMappedDictionary() override;
@@ -53,6 +113,21 @@ private:
 public:
     enum class OptionBits {
         HAS_INFLECTION_TABLE = 1,
+        /**
+         * The file ends with a trie of the title case and uppercase forms of lowercase words.
+         * Each form has the same data as the lowercase word, which is what a lowercase retry would find.
+         */
+        HAS_CASE_FOLDED_WORDS = 2,
+        /**
+         * The file ends with a MembershipFilter of all of the words, including the case folded words.
+         * A word that the filter rejects is not looked up in the tries.
+         */
+        HAS_MEMBERSHIP_FILTER = 4,
+        /**
+         * The file ends with a trie of lemmas, and each lemma points to the inflection pattern and word identifiers
+         * of the words that inflect from it.
+         */
+        HAS_LEMMA_INDEX = 8,
     };
     static constexpr int16_t OPTIONS = {  }; // Space reserved for options. Also used to align data structures after this header. Ideally align to 8 byte boundaries for 64-bit CPU architectures.
     static constexpr int16_t ENDIANNESS_MARKER = 1;
@@ -64,6 +139,11 @@ private:
     int16_t options {  };
     ::inflection::util::ULocale locale;
     ::inflection::dictionary::metadata::StringArrayContainer typesStringContainer {  };
+    /**
+     * An open addressing hash table of the identifiers in typesStringContainer, which is built when the dictionary is
+     * loaded. Empty slots are -1. Resolving a type name probes this instead of binary searching the names.
+     */
+    ::std::vector<int32_t> typeIdentifierHashTable {  };
     int8_t bitsTypesSingletons {  };
     int8_t bitsPropertyMapId {  };
     int8_t bitsPropertyValueMapKey {  };
@@ -75,14 +155,25 @@ private:
     ::inflection::dictionary::metadata::StringArrayContainer propertyNameToKeyId {  };
     ::inflection::dictionary::metadata::StringContainer propertyValuesStringContainer {  };
     ::inflection::dictionary::metadata::CompressedArray<int32_t> propertyValueMaps {::std::vector<int32_t>()};
-    ::std::unique_ptr<::inflection::dictionary::Inflector> inflector {  };
+    ::std::unique_ptr<::inflection::dictionary::Inflector_MMappedDictionary> inflectorDictionary {  };
+    ::std::unique_ptr<::inflection::dictionary::metadata::MarisaTrie<uint64_t>> caseFoldedWordsToDataTrie {  };
+    ::std::unique_ptr<::inflection::dictionary::metadata::MembershipFilter> membershipFilter {  };
+    ::std::unique_ptr<::inflection::dictionary::metadata::MarisaTrie<int32_t>> lemmaToWordsTrie {  };
+    ::std::unique_ptr<::inflection::dictionary::metadata::CompressedArray<int32_t>> lemmaToWordsEntries {  };
     ::std::unique_ptr<::inflection::util::MemoryMappedFile> memoryMappedRegion {  };
     int32_t inflectionKeyIdentifier { -1 };
     int32_t bitsPropertyValueMapKeyMask {  };
     int32_t bitsPropertyValueMapKeySize {  };
     bool isDoubleStageLookup {  };
+    /**
+     * Counts the inflection patterns and key iterators that reference this dictionary outside a lookup.
+     * A replaced dictionary is not unmapped until this is zero.
+     */
+    mutable ::inflection::util::ShardedCounter references {  };
 
 private:
+    friend class DictionaryMetaData;
     friend class Inflector;
     friend class Inflector_MMappedDictionary;
+    friend class Inflector_InflectionPattern;
 };
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/dictionary/fwd.hpp>
+#include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/resources/MemoryBudget.hpp>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Marks the thread as reading for as long as it uses the dictionary. Nested lookups on the same thread only count the
+ * depth. swapDictionary waits for the threads that started reading before the replacement was published.
+ */
+class INFLECTION_INTERNAL_API inflection::dictionary::DictionaryMetaData::ReadGuard final
+{
+public:
+    explicit ReadGuard(const DictionaryMetaData& metaData);
+    ~ReadGuard();
+
+    const DictionaryMetaData_MMappedDictionary* operator->() const
+    {
+        return dictionary;
+    }
+    const DictionaryMetaData_MMappedDictionary& operator*() const
+    {
+        return *dictionary;
+    }
+
+    /**
+     * Wait until every thread that could have seen a dictionary that was replaced before this call stops reading.
+     */
+    static void waitForReaders();
+
+private:
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    struct ReaderSlot;
+    class ThreadReaderSlot;
+
+    static ::std::vector<ReaderSlot*>& READER_SLOTS();
+    static ReaderSlot& getThreadReaderSlot();
+    static void beginRead(ReaderSlot& slot);
+    static void endRead(ReaderSlot& slot);
+
+    /** Evictions that a reload causes are deferred until the outermost lookup of the thread finishes. */
+    ::inflection::resources::MemoryBudget::LoadScope loadScope {  };
+    ReaderSlot& slot;
+    const DictionaryMetaData_MMappedDictionary* dictionary {  };
+};
@@ -4,6 +4,7 @@
 #include <inflection/dictionary/Inflector.hpp>
 
 #include <inflection/dictionary/Inflector_InflectionPattern.hpp>
+#include <inflection/dictionary/Inflector_Paradigm.hpp>
 #include <inflection/dictionary/DictionaryMetaData.hpp>
 #include <inflection/dictionary/DictionaryMetaData_MMappedDictionary.hpp>
 #include <inflection/npc.hpp>
@@ -12,38 +13,80 @@
 namespace inflection::dictionary {
 
 const Inflector& Inflector::getInflector(const ::inflection::util::ULocale &locale) {
-    const Inflector* result = npc(DictionaryMetaData::createDictionary(locale))->dictionary->inflector.get();
-    if (result == nullptr) {
-        throw ::inflection::exception::NullPointerException(inflection::util::StringViewUtils::to_u16string("Inflector not found for " + locale.getName()));
+    const auto& metaData = *npc(DictionaryMetaData::createDictionary(locale));
+    {
+        DictionaryMetaData::ReadGuard dictionary(metaData);
+        if (dictionary->inflectorDictionary == nullptr) {
+            throw ::inflection::exception::NullPointerException(inflection::util::StringViewUtils::to_u16string("Inflector not found for " + locale.getName()));
+        }
     }
-    return *result;
+    return *npc(metaData.inflector.get());
 }
 
-Inflector::Inflector(inflection::util::MemoryMappedFile& memoryMappedFile, const ::std::u16string& sourcePath, const ::inflection::dictionary::DictionaryMetaData_MMappedDictionary &dictionary)
+Inflector::Inflector(const DictionaryMetaData& metaData)
     : super()
-    , mmappedDictionary(memoryMappedFile, sourcePath, dictionary)
+    , metaData(metaData)
 {
 }
 
 Inflector::~Inflector() = default;
 
+const Inflector_MMappedDictionary& Inflector::getInflectorDictionary(const DictionaryMetaData_MMappedDictionary& dictionary)
+{
+    if (dictionary.inflectorDictionary == nullptr) {
+        throw ::inflection::exception::NullPointerException(u"The dictionary of " + dictionary.getLocale().toString() + u" has no inflection table");
+    }
+    return *dictionary.inflectorDictionary;
+}
+
+void Inflector::getMemoryUsage(::inflection::util::MemoryUsage* usage) const
+{
+    DictionaryMetaData::ReadGuard dictionary(metaData);
+    getInflectorDictionary(*dictionary).addMemoryUsage(usage);
+}
+
 std::optional<Inflector_InflectionPattern> Inflector::getInflectionPatternByName(std::u16string_view name) const
 {
-    auto searchResult = mmappedDictionary.getInflectionPatternIndexFromName(name);
+    DictionaryMetaData::ReadGuard dictionary(metaData);
+    const auto& inflectorDictionary = getInflectorDictionary(*dictionary);
+    auto searchResult = inflectorDictionary.getInflectionPatternIndexFromName(name);
     if (searchResult) {
-        return mmappedDictionary.getInflectionPattern(*searchResult);
+        // The copy into the result references the dictionary.
+        return inflectorDictionary.getInflectionPattern(*searchResult);
     }
 
     return {};
 }
 
 void Inflector::getInflectionPatternsForWord(std::u16string_view word, ::std::vector<Inflector_InflectionPattern> &inflectionPatterns) const {
-    std::vector<int32_t> inflectionIdentifiers;
-    if (mmappedDictionary.getInflectionPatternIdentifiers(inflectionIdentifiers, word)) {
-        for (const auto identifier : inflectionIdentifiers) {
-            inflectionPatterns.push_back(mmappedDictionary.getInflectionPattern(identifier));
-        }
-    }
+    visitInflectionPatternsForWord(word, [&inflectionPatterns](const Inflector_InflectionPattern& inflectionPattern) {
+        inflectionPatterns.push_back(inflectionPattern);
+        return true;
+    });
+}
+
+void Inflector::getInflectionPatternsForWord(std::string_view word, ::std::vector<Inflector_InflectionPattern> &inflectionPatterns) const {
+    visitInflectionPatternsForWord(word, [&inflectionPatterns](const Inflector_InflectionPattern& inflectionPattern) {
+        inflectionPatterns.push_back(inflectionPattern);
+        return true;
+    });
+}
+
+bool Inflector::getWordsForLemma(::std::vector<::std::u16string>* result, std::u16string_view lemma, const Inflector_InflectionPattern& inflectionPattern) const
+{
+    // The pattern may be from a dictionary that was replaced since, and its ids are only meaningful in that one.
+    return inflectionPattern.inflectorDictionary.getWordsForLemma(result, lemma, inflectionPattern.identifierID);
+}
+
+bool Inflector::getParadigm(Inflector_Paradigm* result, std::u16string_view lemma) const
+{
+    bool found = false;
+    visitInflectionPatternsForWord(lemma, [result, lemma, &found](const Inflector_InflectionPattern& inflectionPattern) {
+        inflectionPattern.inflectParadigm(result, lemma);
+        found = true;
+        return true;
+    });
+    return found;
 }
 
 } // namespace inflection::dictionary
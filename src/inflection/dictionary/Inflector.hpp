@@ -3,6 +3,7 @@
  */
 #pragma once
 
+#include <inflection/dictionary/DictionaryMetaData_ReadGuard.hpp>
 #include <inflection/dictionary/Inflector_MMappedDictionary.hpp>
 #include <inflection/dictionary/Inflector_InflectionPattern.hpp>
 #include <inflection/dictionary/fwd.hpp>
@@ -10,8 +11,14 @@
 #include <inflection/Object.hpp>
 #include <optional>
 #include <string>
+#include <utility>
 
-class inflection::dictionary::Inflector
+/**
+ * Looks up the inflection patterns of a language. Each lookup uses the current dictionary of the language, so an
+ * Inflector stays valid when the dictionary is replaced or evicted. The patterns that are kept after a lookup keep
+ * their dictionary mapped.
+ */
+class INFLECTION_INTERNAL_API inflection::dictionary::Inflector
     : public virtual ::inflection::Object
 {
 public:
@@ -20,6 +27,39 @@ public:
 public:
     std::optional<inflection::dictionary::Inflector_InflectionPattern> getInflectionPatternByName(std::u16string_view name) const;
     void getInflectionPatternsForWord(std::u16string_view word, ::std::vector<Inflector_InflectionPattern> &inflectionPatterns) const;
+    /**
+     * Like the UTF-16 version, but the word is UTF-8. No conversion is done for exact matches when the dictionary
+     * has UTF-8 keys.
+     */
+    void getInflectionPatternsForWord(std::string_view word, ::std::vector<Inflector_InflectionPattern> &inflectionPatterns) const;
+    /**
+     * Call visitor(inflectionPattern) for each inflection pattern of the word until it returns false.
+     * Unlike getInflectionPatternsForWord, no container is allocated for the patterns.
+     * The dictionary is in use until this returns, so the visitor must not replace it. Copy the pattern to keep it.
+     * @return false when the visitor stopped the iteration.
+     */
+    template <typename Visitor>
+    bool visitInflectionPatternsForWord(std::u16string_view word, Visitor&& visitor) const;
+    /**
+     * Like the UTF-16 version, but the word is UTF-8.
+     */
+    template <typename Visitor>
+    bool visitInflectionPatternsForWord(std::string_view word, Visitor&& visitor) const;
+    /**
+     * Get the words of the dictionary that inflect from the lemma with the inflection pattern, such as the paradigm
+     * of the lemma. The time taken is proportional to the number of words of the lemma, and not the dictionary size.
+     * @param result The words are appended to this vector.
+     * @return false when the dictionary was built without a lemma index.
+     */
+    bool getWordsForLemma(::std::vector<::std::u16string>* result, std::u16string_view lemma, const Inflector_InflectionPattern& inflectionPattern) const;
+    /**
+     * Generate every form of the lemma with each of its inflection patterns. This is faster than inflecting the lemma
+     * once for each combination of grammemes, because the lemma and its patterns are only looked up once,
+     * and the lemma suffix is only removed once per pattern. Each form records which pattern generated it.
+     * @param result The forms are appended to this paradigm. Call clear() to reuse it for another lemma.
+     * @return false when the lemma has no inflection pattern.
+     */
+    bool getParadigm(Inflector_Paradigm* result, std::u16string_view lemma) const;
 
     /**
      * Factory method to return a Inflector singleton for each locale.
@@ -28,8 +68,21 @@ public:
      */
     static const Inflector& getInflector(const ::inflection::util::ULocale& locale);
 
+    /**
+     * Add the mapped, resident and heap memory of each section of the inflection table.
+     */
+    void getMemoryUsage(::inflection::util::MemoryUsage* usage) const;
+
+private:
+    /**
+     * @throws NullPointerException when the dictionary has no inflection table.
+     */
+    static const Inflector_MMappedDictionary& getInflectorDictionary(const DictionaryMetaData_MMappedDictionary& dictionary);
+    template <typename Visitor>
+    static bool visitInflectionPatternsInRange(const Inflector_MMappedDictionary& inflectorDictionary, int32_t offset, int32_t length, Visitor&& visitor);
+
 private:
-    explicit Inflector(inflection::util::MemoryMappedFile& memoryMappedFile, const ::std::u16string& sourcePath, const ::inflection::dictionary::DictionaryMetaData_MMappedDictionary &dictionary);
+    explicit Inflector(const DictionaryMetaData& metaData);
 
 public:
     ~Inflector() override;
@@ -37,9 +90,40 @@ public:
 private:
     Inflector(const Inflector& other) = delete;
     Inflector& operator=(const Inflector& other) = delete;
-    const Inflector_MMappedDictionary mmappedDictionary;
+    const DictionaryMetaData& metaData;
 
-    friend class DictionaryMetaData_MMappedDictionary;
-    friend class Inflector_Inflection;
-    friend class Inflector_InflectionPattern;
+    friend class DictionaryMetaData;
 };
+
+template <typename Visitor>
+bool inflection::dictionary::Inflector::visitInflectionPatternsInRange(const Inflector_MMappedDictionary& inflectorDictionary, int32_t offset, int32_t length, Visitor&& visitor)
+{
+    for (int32_t idx = 0; idx < length; idx++) {
+        if (!visitor(inflectorDictionary.getInflectionPattern(inflectorDictionary.getInflectionPatternIdentifierAt(offset + idx)))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Visitor>
+bool inflection::dictionary::Inflector::visitInflectionPatternsForWord(std::u16string_view word, Visitor&& visitor) const
+{
+    DictionaryMetaData::ReadGuard dictionary(metaData);
+    const auto& inflectorDictionary = getInflectorDictionary(*dictionary);
+    int32_t offset = 0;
+    int32_t length = 0;
+    inflectorDictionary.getInflectionPatternIdentifiersRange(&offset, &length, word);
+    return visitInflectionPatternsInRange(inflectorDictionary, offset, length, ::std::forward<Visitor>(visitor));
+}
+
+template <typename Visitor>
+bool inflection::dictionary::Inflector::visitInflectionPatternsForWord(std::string_view word, Visitor&& visitor) const
+{
+    DictionaryMetaData::ReadGuard dictionary(metaData);
+    const auto& inflectorDictionary = getInflectorDictionary(*dictionary);
+    int32_t offset = 0;
+    int32_t length = 0;
+    inflectorDictionary.getInflectionPatternIdentifiersRange(&offset, &length, word);
+    return visitInflectionPatternsInRange(inflectorDictionary, offset, length, ::std::forward<Visitor>(visitor));
+}
@@ -18,23 +18,26 @@ Inflector_Inflection::Inflector_Inflection(
 
 ::std::u16string Inflector_Inflection::inflect(const ::std::u16string& lemma) const
 {
-    std::u16string suffix = getSuffix();
-    const auto& parent = *npc(inflectionPattern);
-
-    for (int16_t i = 0; i < parent.lemmaSuffixesLen; ++i) {
-        std::u16string lemmaSuffix(parent.inflectorDictionary.inflectionSuffixes.getString(
-                parent.inflectorDictionary.inflectionsArray.read(parent.lemmaSuffixesOffset + i)));
-        if (lemma.ends_with(lemmaSuffix)) {
-            return lemma.substr(0, lemma.size() - lemmaSuffix.size()) + suffix;
-        }
-    }
-
-    return lemma + suffix;
+    ::std::u16string suffixBuffer;
+    const auto suffix(getSuffixView(&suffixBuffer));
+    const auto stemLength = npc(inflectionPattern)->getStemLength(lemma);
+
+    ::std::u16string result;
+    result.reserve(stemLength + suffix.size());
+    result.append(lemma, 0, stemLength);
+    result.append(suffix);
+    return result;
 }
 
 ::std::u16string Inflector_Inflection::getSuffix() const
 {
-    return npc(inflectionPattern)->inflectorDictionary.inflectionSuffixes.getString(suffixId);
+    ::std::u16string suffixBuffer;
+    return ::std::u16string(getSuffixView(&suffixBuffer));
+}
+
+::std::u16string_view Inflector_Inflection::getSuffixView(::std::u16string* buffer) const
+{
+    return npc(inflectionPattern)->inflectorDictionary.getInflectionSuffix(buffer, suffixId);
 }
 
 int64_t Inflector_Inflection::getGrammemes() const {
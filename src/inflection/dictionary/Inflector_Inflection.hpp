@@ -5,8 +5,9 @@
 
 #include <inflection/dictionary/fwd.hpp>
 #include <string>
+#include <string_view>
 
-class inflection::dictionary::Inflector_Inflection final
+class INFLECTION_INTERNAL_API inflection::dictionary::Inflector_Inflection final
 {
 private:
     const Inflector_InflectionPattern* inflectionPattern;
@@ -24,6 +25,11 @@ public:
 
 private: /* package */
     Inflector_Inflection(const Inflector_InflectionPattern& inflectionPattern, int32_t suffixId, int64_t grammemes);
+    /**
+     * Same as getSuffix, but without the copy. The view points either into the dictionary or into buffer,
+     * so it's valid until buffer is changed.
+     */
+    ::std::u16string_view getSuffixView(::std::u16string* buffer) const;
 
 private:
     friend class Inflector;
@@ -4,10 +4,12 @@
 #include <inflection/dictionary/Inflector_InflectionPattern.hpp>
 
 #include <inflection/dictionary/Inflector_Inflection.hpp>
+#include <inflection/dictionary/Inflector_Paradigm.hpp>
 #include <inflection/dictionary/DictionaryMetaData_MMappedDictionary.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/LoggerConfig.hpp>
 #include <inflection/util/Logger.hpp>
+#include <algorithm>
 #include <bit>
 #include <string>
 #include <vector>
@@ -29,15 +31,51 @@ Inflector_InflectionPattern::Inflector_InflectionPattern(int32_t identifierID, i
 {
 }
 
+/**
+ * A pattern that was just looked up is only used within the lookup, so it starts counting the dictionary references
+ * when it's copied out of the lookup. A copy of a counted pattern is counted like the original.
+ */
+::inflection::util::ShardedCounter_Reference Inflector_InflectionPattern::copyReference() const
+{
+    if (reference.isEmpty()) {
+        return ::inflection::util::ShardedCounter_Reference(inflectorDictionary.dictionary.references);
+    }
+    return ::inflection::util::ShardedCounter_Reference(reference);
+}
+
+Inflector_InflectionPattern::Inflector_InflectionPattern(const Inflector_InflectionPattern& other)
+    : identifierID(other.identifierID)
+    , frequencyIdx(other.frequencyIdx)
+    , partsOfSpeech(other.partsOfSpeech)
+    , lemmaSuffixesLen(other.lemmaSuffixesLen)
+    , numOfInflections(other.numOfInflections)
+    , lemmaSuffixesOffset(other.lemmaSuffixesOffset)
+    , inflectionsArrayStart(other.inflectionsArrayStart)
+    , inflectorDictionary(other.inflectorDictionary)
+    , reference(other.copyReference())
+{
+}
+
+Inflector_InflectionPattern::Inflector_InflectionPattern(Inflector_InflectionPattern&& other) noexcept
+    : identifierID(other.identifierID)
+    , frequencyIdx(other.frequencyIdx)
+    , partsOfSpeech(other.partsOfSpeech)
+    , lemmaSuffixesLen(other.lemmaSuffixesLen)
+    , numOfInflections(other.numOfInflections)
+    , lemmaSuffixesOffset(other.lemmaSuffixesOffset)
+    , inflectionsArrayStart(other.inflectionsArrayStart)
+    , inflectorDictionary(other.inflectorDictionary)
+    , reference(other.reference.isEmpty() ? ::inflection::util::ShardedCounter_Reference(inflectorDictionary.dictionary.references) : ::std::move(other.reference))
+{
+}
+
+Inflector_InflectionPattern::~Inflector_InflectionPattern() = default;
+
 inline static bool containsAll(int64_t superset, int64_t subset){
     return (superset & subset) == subset;
 }
 
-Inflector_Inflection inflection::dictionary::Inflector_InflectionPattern::getInflectionAtPosition(int32_t idx) const {
-    if (idx >= numOfInflections) {
-        throw inflection::exception::IndexOutOfBoundsException(u"index too large for getInflectionAtPosition");
-    }
-    uint64_t value = inflectorDictionary.inflectionsArray.read(inflectionsArrayStart + idx);
+Inflector_Inflection Inflector_InflectionPattern::createInflection(uint64_t value) const {
     auto grammemesIdx = inflection::dictionary::metadata::CompressedArray<int32_t>::extractValue(value, 0, inflectorDictionary.numBitsForGrammemesIdx);
     value >>= inflectorDictionary.numBitsForGrammemesIdx;
     auto suffixIdx = inflection::dictionary::metadata::CompressedArray<int32_t>::extractValue(value, 0, inflectorDictionary.numBitsForSuffixIdx);
@@ -49,67 +87,109 @@ Inflector_Inflection inflection::dictionary::Inflector_InflectionPattern::getInf
     };
 }
 
+Inflector_Inflection inflection::dictionary::Inflector_InflectionPattern::getInflectionAtPosition(int32_t idx) const {
+    if (idx >= numOfInflections) {
+        throw inflection::exception::IndexOutOfBoundsException(u"index too large for getInflectionAtPosition");
+    }
+    return createInflection(inflectorDictionary.inflectionsArray.read(inflectionsArrayStart + idx));
+}
+
+/**
+ * Call the visitor with each inflection in order until it returns false.
+ * The inflections are decoded in chunks so that the range is only validated once per chunk.
+ * @return false when the visitor stopped the iteration.
+ */
+template <typename Visitor>
+bool Inflector_InflectionPattern::visitInflections(Visitor&& visitor) const {
+    static constexpr int32_t CHUNK_SIZE = 64;
+    int64_t values[CHUNK_SIZE];
+    for (int32_t chunkStart = 0; chunkStart < numOfInflections; chunkStart += CHUNK_SIZE) {
+        const int32_t chunkLength = ::std::min(CHUNK_SIZE, numOfInflections - chunkStart);
+        inflectorDictionary.inflectionsArray.readRange(values, inflectionsArrayStart + chunkStart, chunkLength);
+        for (int32_t idx = 0; idx < chunkLength; idx++) {
+            if (!visitor(createInflection(uint64_t(values[idx])))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+::std::u16string_view::size_type Inflector_InflectionPattern::getStemLength(::std::u16string_view lemma) const
+{
+    ::std::u16string suffixBuffer;
+    for (int16_t i = 0; i < lemmaSuffixesLen; ++i) {
+        const auto lemmaSuffix(inflectorDictionary.getInflectionSuffix(&suffixBuffer, inflectorDictionary.inflectionsArray.read(lemmaSuffixesOffset + i)));
+        if (lemma.ends_with(lemmaSuffix)) {
+            return lemma.size() - lemmaSuffix.size();
+        }
+    }
+    return lemma.size();
+}
+
+void Inflector_InflectionPattern::inflectParadigm(Inflector_Paradigm* result, ::std::u16string_view lemma) const
+{
+    auto& paradigm = *npc(result);
+    paradigm.addPattern(getIdentifier(&paradigm.decodingBuffer));
+    const auto stem(lemma.substr(0, getStemLength(lemma)));
+    visitInflections([&paradigm, stem](const Inflector_Inflection& inflection) {
+        paradigm.add(inflection.getGrammemes(), stem, inflection.getSuffixView(&paradigm.decodingBuffer));
+        return true;
+    });
+}
+
 bool Inflector_InflectionPattern::containsSuffix(std::u16string_view suffix) const
 {
     const auto suffixID = inflectorDictionary.inflectionSuffixes.getIdentifierIfAvailable(suffix);
     if (suffixID >= 0) {
-        for (int16_t i = 0; i < numOfInflections; ++i) {
-            if (getInflectionAtPosition(i).suffixId == suffixID) {
-                return true;
-            }
-        }
+        return !visitInflections([suffixID](const Inflector_Inflection& inflection) {
+            return inflection.suffixId != suffixID;
+        });
     }
     return false;
 }
 
 bool Inflector_InflectionPattern::containsGrammemes(int64_t grammemes) const {
-    for (int16_t i = 0; i < numOfInflections; ++i) {
-        if (((getInflectionAtPosition(i).grammemes | partsOfSpeech) & grammemes) == grammemes) {
-            return true;
-        }
-    }
-    return false;
+    return !visitInflections([this, grammemes](const Inflector_Inflection& inflection) {
+        return ((inflection.grammemes | partsOfSpeech) & grammemes) != grammemes;
+    });
 }
 
 ::std::vector<Inflector_Inflection> Inflector_InflectionPattern::constrain(const ::std::vector<::std::u16string>& constraints, bool isSuperset) const {
     int64_t constraintGrammemes = inflectorDictionary.dictionary.getValuesOfTypes(constraints);
     ::std::vector<Inflector_Inflection> results;
-    for (int16_t i = 0; i < numOfInflections; ++i) {
-        const auto &inflection = getInflectionAtPosition(i);
+    visitInflections([&results, constraintGrammemes, isSuperset](const Inflector_Inflection& inflection) {
         int64_t inflectionGrammemes = inflection.getGrammemes();
 
         if (isSuperset ? containsAll(constraintGrammemes, inflectionGrammemes) : containsAll(inflectionGrammemes, constraintGrammemes)) {
             results.push_back(inflection);
         }
-    }
+        return true;
+    });
     return results;
 }
 
 ::std::vector<Inflector_Inflection> Inflector_InflectionPattern::inflectionsForSurfaceForm(::std::u16string_view surfaceForm, int64_t fromGrammemes) const {
     ::std::vector<Inflector_Inflection> results;
     int64_t maxLen = -1;
-    int32_t lastSuffixId = -1;
-    std::u16string suffix;
-    for (int16_t i = 0; i < numOfInflections; ++i) {
-        const auto inflection(getInflectionAtPosition(i));
+    ::std::u16string suffixBuffer;
+    visitInflections([&](const Inflector_Inflection& inflection) {
         int64_t inflectionGrammemes = inflection.getGrammemes();
         if (!containsAll(fromGrammemes, inflectionGrammemes)) {
-            continue;
-        }
-        if (lastSuffixId != inflection.suffixId) {
-            lastSuffixId = inflection.suffixId;
-            suffix = inflection.getSuffix();
+            return true;
         }
+        const auto suffix(inflection.getSuffixView(&suffixBuffer));
         auto sufLen = (int64_t) suffix.size();
         if (sufLen < maxLen || !surfaceForm.ends_with(suffix)) {
-            continue;
+            return true;
         }
         if (sufLen > maxLen) {
             results.clear();
             maxLen = sufLen;
         }
         results.push_back(inflection);
-    }
+        return true;
+    });
     return results;
 }
 
@@ -127,7 +207,9 @@ std::u16string Inflector_InflectionPattern::reinflectImplementation(int64_t from
     }
 
     int16_t longestLemmaSuffixLen = 0;
-    std::optional<std::u16string> bestSurfaceFormSuffix;
+    // The id instead of the suffix, since the suffix may be in a buffer that the next inflection reuses.
+    std::optional<int32_t> bestSurfaceFormSuffixId;
+    ::std::u16string suffixBuffer;
     const auto toConstraintsBitCount = std::popcount(static_cast<uint64_t>(toConstraints));
     
     struct SurfaceFormMatchScore {
@@ -139,56 +221,84 @@ std::u16string Inflector_InflectionPattern::reinflectImplementation(int64_t from
     
     SurfaceFormMatchScore surfaceFormMatchScore;
 
-    for (int16_t i = 0; i < numOfInflections; ++i) {
-        const auto& inflection = getInflectionAtPosition(i);
-        int64_t inflectionGrammemes = inflection.getGrammemes();
+    const auto updateLongestLemmaSuffix = [&](int64_t inflectionGrammemes, std::u16string_view surfaceFormSuffix) {
         // These surfaceForm grammeme should have been derived from the dictionary entry.
-        
+
         // If the current surfaceForm grammemes are "masculine, singular",
         // don't consider "masculine, plural", "feminine, singular" nor "masculine, singular, genitive".
-        
+
         // If the current surfaceForm grammemes are "feminine, masculine, singular",
         // do consider "masculine, singular" and "feminine, singular" but not anything with "plural".
-        
+
         // If the current surfaceForm grammemes are unknown, make the best guess.
-        const std::u16string surfaceFormSuffix(inflection.getSuffix());
         if ((fromGrammemes == 0) || containsAll(fromGrammemes, inflectionGrammemes)) {
             auto surfaceFormSuffixSize = (int16_t) surfaceFormSuffix.size();
             if (longestLemmaSuffixLen < surfaceFormSuffixSize && surfaceForm.ends_with(surfaceFormSuffix)) {
                 longestLemmaSuffixLen = surfaceFormSuffixSize;
             }
         }
-        if (containsAll(inflectionGrammemes, toConstraints)) {
-            // At this point, it's not a no, but it's not the best either.
-            // Perhaps you asked for the "plural" form, but there are both "masculine" and "feminine" forms.
-            // Perhaps you asked for the "plural, feminine" form, but there are both "nominative" and "genitive" forms.
-            // Try to find one where the fewest unreferenced grammemes are changing.
-            const auto numberOfMatches = std::popcount(static_cast<uint64_t>(inflectionGrammemes & fromGrammemes));
-            int64_t optionalConstraintsMatchScore = 0;
-            for (const auto constraintGrammeme : toOptionalConstraints) {
-                optionalConstraintsMatchScore = 2 * optionalConstraintsMatchScore + (((inflectionGrammemes & constraintGrammeme) != 0) ? 1 : 0);
-            }
+    };
+
+    // The inflection with all of the constraints and all of the current grammemes, and nothing else, matches the most
+    // grammemes with the fewest changes. When it also has all of the optional constraints, no other inflection can score
+    // higher, and only the first one with those grammemes wins a tie. So that exact match is found with the grammeme index,
+    // the stem is found with the suffix index, and the scoring below is only needed for the partial matches.
+    const bool traceEnabled = INFLECTION_IS_TRACE_ENABLED();
+    const int64_t exactGrammemes = toConstraints | fromGrammemes;
+    int32_t exactPosition = -1;
+    if (std::ranges::all_of(toOptionalConstraints, [exactGrammemes](int64_t constraintGrammeme) { return (exactGrammemes & constraintGrammeme) != 0; })) {
+        exactPosition = inflectorDictionary.findInflectionPositionWithGrammemes(identifierID, exactGrammemes);
+    }
+    if (exactPosition >= 0) {
+        longestLemmaSuffixLen = (int16_t) inflectorDictionary.findLongestInflectionSuffixLength(identifierID, fromGrammemes, surfaceForm);
+        bestSurfaceFormSuffixId = getInflectionAtPosition(exactPosition).suffixId;
+        if (traceEnabled) {
+            util::Logger::trace(std::u16string(u"reinflect result exact match suffix: ") + std::u16string(inflectorDictionary.getInflectionSuffix(&suffixBuffer, *bestSurfaceFormSuffixId)));
+        }
+    } else {
+        visitInflections([&](const Inflector_Inflection& inflection) {
+            int64_t inflectionGrammemes = inflection.getGrammemes();
+            const std::u16string_view surfaceFormSuffix(inflection.getSuffixView(&suffixBuffer));
+            updateLongestLemmaSuffix(inflectionGrammemes, surfaceFormSuffix);
+            if (containsAll(inflectionGrammemes, toConstraints)) {
+                // At this point, it's not a no, but it's not the best either.
+                // Perhaps you asked for the "plural" form, but there are both "masculine" and "feminine" forms.
+                // Perhaps you asked for the "plural, feminine" form, but there are both "nominative" and "genitive" forms.
+                // Try to find one where the fewest unreferenced grammemes are changing.
+                const auto numberOfMatches = std::popcount(static_cast<uint64_t>(inflectionGrammemes & fromGrammemes));
+                int64_t optionalConstraintsMatchScore = 0;
+                for (const auto constraintGrammeme : toOptionalConstraints) {
+                    optionalConstraintsMatchScore = 2 * optionalConstraintsMatchScore + (((inflectionGrammemes & constraintGrammeme) != 0) ? 1 : 0);
+                }
             
-            const auto currentUnmatchedNegative = -(std::popcount(static_cast<uint64_t>(inflectionGrammemes)) - toConstraintsBitCount);
+                const auto currentUnmatchedNegative = -(std::popcount(static_cast<uint64_t>(inflectionGrammemes)) - toConstraintsBitCount);
             
-            const SurfaceFormMatchScore currentSurfaceFormMatchScore{optionalConstraintsMatchScore, numberOfMatches, currentUnmatchedNegative};
-
-            if (util::LoggerConfig::isTraceEnabled()) {
-                // Logging reinflect inflection candidate
-                util::Logger::trace(std::u16string(u"reinflect result candidate suffix: ")
-                          + std::u16string(surfaceFormSuffix) + u" , inflectionGrammemes: ["
-                          + inflection::util::StringViewUtils::join(inflectorDictionary.dictionary.getTypesOfValues(inflectionGrammemes), u", ")
-                          + u"], Number of matches with existing grammemes: " + util::StringUtils::to_u16string(numberOfMatches)
-                                    + u", Optional Constraint Match Score: " + util::StringUtils::to_u16string(optionalConstraintsMatchScore));
-            }
-            if (currentSurfaceFormMatchScore > surfaceFormMatchScore) {
-                surfaceFormMatchScore = currentSurfaceFormMatchScore;
-                bestSurfaceFormSuffix = surfaceFormSuffix;
+                const SurfaceFormMatchScore currentSurfaceFormMatchScore{optionalConstraintsMatchScore, numberOfMatches, currentUnmatchedNegative};
+
+                if (traceEnabled) {
+                    // Logging reinflect inflection candidate
+                    util::Logger::trace(std::u16string(u"reinflect result candidate suffix: ")
+                              + std::u16string(surfaceFormSuffix) + u" , inflectionGrammemes: ["
+                              + inflection::util::StringViewUtils::join(inflectorDictionary.dictionary.getTypesOfValues(inflectionGrammemes), u", ")
+                              + u"], Number of matches with existing grammemes: " + util::StringUtils::to_u16string(numberOfMatches)
+                                        + u", Optional Constraint Match Score: " + util::StringUtils::to_u16string(optionalConstraintsMatchScore));
+                }
+                if (currentSurfaceFormMatchScore > surfaceFormMatchScore) {
+                    surfaceFormMatchScore = currentSurfaceFormMatchScore;
+                    bestSurfaceFormSuffixId = inflection.suffixId;
+                }
             }
-        }
+            return true;
+        });
     }
-    if (bestSurfaceFormSuffix.has_value()) {
-        return ::std::u16string(surfaceForm.substr(0, surfaceForm.size() - longestLemmaSuffixLen)) + bestSurfaceFormSuffix.value();
+    if (bestSurfaceFormSuffixId.has_value()) {
+        const auto stem(surfaceForm.substr(0, surfaceForm.size() - longestLemmaSuffixLen));
+        const auto bestSurfaceFormSuffix(inflectorDictionary.getInflectionSuffix(&suffixBuffer, *bestSurfaceFormSuffixId));
+        ::std::u16string result;
+        result.reserve(stem.size() + bestSurfaceFormSuffix.size());
+        result.append(stem);
+        result.append(bestSurfaceFormSuffix);
+        return result;
     }
     // It just doesn't exist. Perhaps it's uninflectable, like sheep or news.
     return {};
@@ -204,7 +314,13 @@ std::u16string Inflector_InflectionPattern::reinflectImplementation(int64_t from
 
 ::std::u16string Inflector_InflectionPattern::getIdentifier() const
 {
-    return inflectorDictionary.identifierToInflectionPatternTrie.getKey(identifierID);
+    ::std::u16string result;
+    return ::std::u16string(inflectorDictionary.getInflectionPatternIdentifier(&result, identifierID));
+}
+
+::std::u16string_view Inflector_InflectionPattern::getIdentifier(::std::u16string* buffer) const
+{
+    return inflectorDictionary.getInflectionPatternIdentifier(buffer, identifierID);
 }
 
 int32_t Inflector_InflectionPattern::getFrequency() const
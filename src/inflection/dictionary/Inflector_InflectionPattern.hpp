@@ -6,10 +6,11 @@
 #include <inflection/dictionary/fwd.hpp>
 #include <inflection/dictionary/Inflector_Inflection.hpp>
 #include <inflection/dictionary/Inflector_MMappedDictionary.hpp>
+#include <inflection/util/ShardedCounter_Reference.hpp>
 #include <string>
 #include <vector>
 
-class inflection::dictionary::Inflector_InflectionPattern final
+class INFLECTION_INTERNAL_API inflection::dictionary::Inflector_InflectionPattern final
 {
 private: /* package */
     const int32_t identifierID { 0 };
@@ -20,22 +21,50 @@ private: /* package */
     const int32_t lemmaSuffixesOffset {  };
     const int32_t inflectionsArrayStart {  };
     const ::inflection::dictionary::Inflector_MMappedDictionary& inflectorDictionary;
+    /**
+     * Keeps the dictionary mapped when this pattern outlives the lookup that found it.
+     * A pattern that is only visited during a lookup doesn't need it.
+     */
+    ::inflection::util::ShardedCounter_Reference reference {  };
 
 private:
+    ::inflection::util::ShardedCounter_Reference copyReference() const;
     Inflector_Inflection getInflectionAtPosition(int32_t idx) const;
+    Inflector_Inflection createInflection(uint64_t value) const;
+    template <typename Visitor>
+    bool visitInflections(Visitor&& visitor) const;
+    ::std::u16string_view::size_type getStemLength(::std::u16string_view lemma) const;
     ::std::u16string reinflectImplementation(int64_t fromGrammemes, int64_t toConstraints, const std::vector<int64_t> &toOptionalConstraints, std::u16string_view surfaceForm) const;
 
+public:
+    /**
+     * A copy references the dictionary of the pattern, so it can outlive the lookup that found the pattern.
+     */
+    Inflector_InflectionPattern(const Inflector_InflectionPattern& other);
+    Inflector_InflectionPattern(Inflector_InflectionPattern&& other) noexcept;
+    ~Inflector_InflectionPattern();
+
 public:
     ::std::vector<Inflector_Inflection> constrain(const ::std::vector<::std::u16string>& constraints, bool isSuperset) const;
 public:
     ::std::vector<::inflection::dictionary::Inflector_Inflection> inflectionsForSurfaceForm(::std::u16string_view surfaceForm, int64_t fromGrammemes) const;
     ::std::u16string reinflect(int64_t fromGrammemes, int64_t toConstraints, std::u16string_view surfaceForm) const;
     ::std::u16string reinflectWithOptionalConstraints(int64_t fromGrammemes, int64_t toConstraints, const std::vector<int64_t> &toOptionalConstraints, std::u16string_view surfaceForm) const;
+    /**
+     * Append every inflection of this pattern, in the order of the pattern, applied to the lemma.
+     * The lemma suffix is removed once for all of the inflections.
+     */
+    void inflectParadigm(Inflector_Paradigm* result, ::std::u16string_view lemma) const;
     bool containsSuffix(std::u16string_view suffix) const;
     bool containsGrammemes(int64_t grammemes) const;
 
     int32_t getFrequency() const;
     ::std::u16string getIdentifier() const;
+    /**
+     * Get the identifier without allocating a new string.
+     * The returned view points either into the dictionary or into buffer, so buffer must outlive it.
+     */
+    ::std::u16string_view getIdentifier(::std::u16string* buffer) const;
     int32_t numInflections() const;
 
     int64_t getPartsOfSpeech() const;
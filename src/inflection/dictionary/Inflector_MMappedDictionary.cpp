@@ -7,9 +7,14 @@
 #include <inflection/dictionary/DictionaryMetaData_MMappedDictionary.hpp>
 #include <inflection/dictionary/metadata/CompressedArray.hpp>
 #include <inflection/exception/IncompatibleVersionException.hpp>
+#include <inflection/exception/IndexOutOfBoundsException.hpp>
+#include <inflection/util/MemoryUsage.hpp>
 #include <inflection/util/StringUtils.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/Validate.hpp>
+#include <unicode/utf8.h>
+#include <unicode/utf16.h>
+#include <algorithm>
 
 namespace inflection::dictionary {
 
@@ -27,9 +32,6 @@ static const ::inflection::dictionary::DictionaryMetaData_MMappedDictionary& ver
         throw ::inflection::exception::IOException(u"Inflection file " + sourcePath + u" was built for a different architecture");
     }
 
-    // Read options. Currently unused.
-    mappedFile.readArray<char>(sizeof(Inflector_MMappedDictionary::OPTIONS));
-
     return dictionary;
 }
 
@@ -42,6 +44,7 @@ static auto skipPadding(inflection::util::MemoryMappedFile& memoryMappedFile) {
 
 Inflector_MMappedDictionary::Inflector_MMappedDictionary(inflection::util::MemoryMappedFile& memoryMappedFile, const std::u16string &sourcePath, const ::inflection::dictionary::DictionaryMetaData_MMappedDictionary &dictionary)
     : locale(verifyMemoryMappedFileHeader(memoryMappedFile, sourcePath, dictionary).getLocale())
+    , options(memoryMappedFile.read<int16_t>())
     , grammemePatternsSize(memoryMappedFile.read<int32_t>())
     , grammemePatterns(memoryMappedFile.readArray<int64_t>(grammemePatternsSize))
     , inflectionSuffixes(&memoryMappedFile)
@@ -60,6 +63,24 @@ Inflector_MMappedDictionary::Inflector_MMappedDictionary(inflection::util::Memor
     , identifierToInflectionPatternTrie(&memoryMappedFile)
 {
     inflection::util::Validate::isTrue(numBitsForLemmaSuffixesLen <= 1, u"Multiple lemma suffixes are not supported.");
+    if ((options & (int16_t)OptionBits::MATERIALIZE_PATTERN_IDENTIFIERS) != 0) {
+        const auto numPatterns = identifierToInflectionPatternTrie.getSize();
+        patternIdentifierOffsets.reserve(numPatterns + 1);
+        for (int32_t id = 0; id < numPatterns; id++) {
+            patternIdentifierOffsets.emplace_back(int32_t(patternIdentifiers.length()));
+            identifierToInflectionPatternTrie.appendKey(&patternIdentifiers, id);
+        }
+        patternIdentifierOffsets.emplace_back(int32_t(patternIdentifiers.length()));
+    }
+    if ((options & (int16_t)OptionBits::DECODE_INFLECTION_SUFFIXES) != 0) {
+        const auto numSuffixes = inflectionSuffixes.size();
+        decodedSuffixOffsets.reserve(numSuffixes + 1);
+        for (int32_t id = 0; id < numSuffixes; id++) {
+            decodedSuffixOffsets.emplace_back(int32_t(decodedSuffixes.length()));
+            inflectionSuffixes.appendString(&decodedSuffixes, id);
+        }
+        decodedSuffixOffsets.emplace_back(int32_t(decodedSuffixes.length()));
+    }
 }
 
 Inflector_MMappedDictionary::~Inflector_MMappedDictionary() = default;
@@ -68,6 +89,164 @@ std::optional<int16_t> Inflector_MMappedDictionary::getInflectionPatternIndexFro
     return identifierToInflectionPatternTrie.getKeyId(name);
 }
 
+::std::u16string_view Inflector_MMappedDictionary::getInflectionPatternIdentifier(::std::u16string* buffer, int32_t id) const {
+    if (!patternIdentifierOffsets.empty()) {
+        if (id < 0 || id + 1 >= int32_t(patternIdentifierOffsets.size())) {
+            throw ::inflection::exception::IndexOutOfBoundsException(u"Invalid inflection pattern id");
+        }
+        return ::std::u16string_view(patternIdentifiers).substr(patternIdentifierOffsets[id], patternIdentifierOffsets[id + 1] - patternIdentifierOffsets[id]);
+    }
+    identifierToInflectionPatternTrie.getKey(buffer, id);
+    return *buffer;
+}
+
+void Inflector_MMappedDictionary::appendInflectionPatternIdentifier(::std::u16string* dest, int32_t id) const {
+    if (!patternIdentifierOffsets.empty()) {
+        ::std::u16string unused;
+        npc(dest)->append(getInflectionPatternIdentifier(&unused, id));
+        return;
+    }
+    identifierToInflectionPatternTrie.appendKey(dest, id);
+}
+
+void Inflector_MMappedDictionary::appendInflectionPatternIdentifier(::std::string* dest, int32_t id) const {
+    if (!patternIdentifierOffsets.empty()) {
+        // Transcoding the materialized identifier is cheaper than a trie reverse lookup.
+        ::std::u16string unused;
+        auto identifier(getInflectionPatternIdentifier(&unused, id));
+        auto identifierChars = identifier.data();
+        int32_t length = int32_t(identifier.length());
+        char buffer[U8_MAX_LENGTH] = {0};
+        UChar32 ch = 0;
+        int32_t idx = 0;
+        while (idx < length) {
+            U16_NEXT(identifierChars, idx, length, ch);
+            int32_t idx8 = 0;
+            U8_APPEND_UNSAFE(buffer, idx8, ch);
+            npc(dest)->append(buffer, idx8);
+        }
+        return;
+    }
+    identifierToInflectionPatternTrie.appendKey(dest, id);
+}
+
+::std::u16string_view Inflector_MMappedDictionary::getInflectionSuffix(::std::u16string* buffer, int32_t id) const {
+    if (!decodedSuffixOffsets.empty()) {
+        if (id < 0 || id + 1 >= int32_t(decodedSuffixOffsets.size())) {
+            throw ::inflection::exception::IndexOutOfBoundsException(u"Invalid inflection suffix id");
+        }
+        return ::std::u16string_view(decodedSuffixes).substr(decodedSuffixOffsets[id], decodedSuffixOffsets[id + 1] - decodedSuffixOffsets[id]);
+    }
+    npc(buffer)->clear();
+    inflectionSuffixes.appendString(buffer, id);
+    return *buffer;
+}
+
+bool Inflector_MMappedDictionary::getWordsForLemma(::std::vector<::std::u16string>* result, std::u16string_view lemma, int32_t inflectionPatternId) const {
+    return dictionary.getWordsForLemma(result, lemma, inflectionPatternId);
+}
+
+bool Inflector_MMappedDictionary::hasInflectionGrammemeIndex() const {
+    return (options & (int16_t)OptionBits::INDEX_INFLECTION_GRAMMEMES) != 0;
+}
+
+bool Inflector_MMappedDictionary::buildInflectionIndexes() const {
+    if (!hasInflectionGrammemeIndex()) {
+        return false;
+    }
+    // Decoding every pattern takes a while, so it's only done for the dictionaries that are searched this way.
+    ::std::call_once(inflectionIndexesOnce, [this]() {
+        const auto numPatterns = identifierToInflectionPatternTrie.getSize();
+        inflectionIndexOffsets.reserve(numPatterns + 1);
+        inflectionSuffixMaxLengths.reserve(numPatterns);
+        for (int32_t id = 0; id < numPatterns; id++) {
+            const auto patternStart = int32_t(inflectionGrammemeIndex.size());
+            inflectionIndexOffsets.emplace_back(patternStart);
+            int32_t suffixMaxLength = 0;
+            ::std::u16string suffixBuffer;
+            const auto inflectionPattern(getInflectionPattern(id));
+            for (int32_t position = 0; position < inflectionPattern.numOfInflections; position++) {
+                const auto inflection(inflectionPattern.getInflectionAtPosition(position));
+                inflectionGrammemeIndex.push_back({inflection.getGrammemes(), position});
+                inflectionSuffixIndex.push_back({inflection.getGrammemes(), inflection.suffixId});
+                suffixMaxLength = ::std::max(suffixMaxLength, int32_t(inflection.getSuffixView(&suffixBuffer).size()));
+            }
+            inflectionSuffixMaxLengths.emplace_back(suffixMaxLength);
+            ::std::sort(inflectionGrammemeIndex.begin() + patternStart, inflectionGrammemeIndex.end(), [](const InflectionGrammemeIndexEntry& entry1, const InflectionGrammemeIndexEntry& entry2) {
+                return entry1.grammemes < entry2.grammemes || (entry1.grammemes == entry2.grammemes && entry1.position < entry2.position);
+            });
+            ::std::sort(inflectionSuffixIndex.begin() + patternStart, inflectionSuffixIndex.end(), [](const InflectionSuffixIndexEntry& entry1, const InflectionSuffixIndexEntry& entry2) {
+                return entry1.suffixId < entry2.suffixId;
+            });
+        }
+        inflectionIndexOffsets.emplace_back(int32_t(inflectionGrammemeIndex.size()));
+        inflectionIndexesBuilt.store(true, ::std::memory_order_release);
+    });
+    return true;
+}
+
+int32_t Inflector_MMappedDictionary::findInflectionPositionWithGrammemes(int32_t inflectionPatternId, int64_t grammemes) const {
+    if (!buildInflectionIndexes() || inflectionPatternId < 0 || inflectionPatternId + 1 >= int32_t(inflectionIndexOffsets.size())) {
+        return -1;
+    }
+    const auto patternEnd = inflectionGrammemeIndex.begin() + inflectionIndexOffsets[inflectionPatternId + 1];
+    const auto entry = ::std::lower_bound(inflectionGrammemeIndex.begin() + inflectionIndexOffsets[inflectionPatternId], patternEnd, grammemes,
+        [](const InflectionGrammemeIndexEntry& indexEntry, int64_t value) {
+            return indexEntry.grammemes < value;
+        });
+    if (entry == patternEnd || entry->grammemes != grammemes) {
+        return -1;
+    }
+    return entry->position;
+}
+
+int32_t Inflector_MMappedDictionary::findLongestInflectionSuffixLength(int32_t inflectionPatternId, int64_t fromGrammemes, ::std::u16string_view surfaceForm) const {
+    if (!buildInflectionIndexes() || inflectionPatternId < 0 || inflectionPatternId + 1 >= int32_t(inflectionIndexOffsets.size())) {
+        return -1;
+    }
+    const auto patternStart = inflectionSuffixIndex.begin() + inflectionIndexOffsets[inflectionPatternId];
+    const auto patternEnd = inflectionSuffixIndex.begin() + inflectionIndexOffsets[inflectionPatternId + 1];
+    // Only the suffixes of the surface form that are as long as the suffixes of the pattern can match.
+    for (auto suffixLength = ::std::min(int32_t(surfaceForm.size()), inflectionSuffixMaxLengths[inflectionPatternId]); suffixLength > 0; suffixLength--) {
+        const auto suffixId = inflectionSuffixes.getIdentifierIfAvailable(surfaceForm.substr(surfaceForm.size() - suffixLength));
+        if (suffixId < 0) {
+            continue;
+        }
+        auto entry = ::std::lower_bound(patternStart, patternEnd, suffixId, [](const InflectionSuffixIndexEntry& indexEntry, int32_t value) {
+            return indexEntry.suffixId < value;
+        });
+        for (; entry != patternEnd && entry->suffixId == suffixId; ++entry) {
+            if (fromGrammemes == 0 || (fromGrammemes & entry->grammemes) == entry->grammemes) {
+                return suffixLength;
+            }
+        }
+    }
+    return 0;
+}
+
+void Inflector_MMappedDictionary::addMemoryUsage(::inflection::util::MemoryUsage* usage) const {
+    npc(usage)->addMapped("inflection grammeme patterns", grammemePatterns, grammemePatternsSize * sizeof(grammemePatterns[0]));
+    inflectionSuffixes.addMemoryUsage(usage, "inflection suffixes");
+    inflectionsArray.addMemoryUsage(usage, "inflections");
+    inflectionPrefixes.addMemoryUsage(usage, "inflection prefixes");
+    npc(usage)->addMapped("inflection frequencies", frequenciesArray, frequencyArraySize * sizeof(frequenciesArray[0]));
+    identifierToInflectionPatternTrie.addMemoryUsage(usage, "inflection pattern identifiers");
+    if (!patternIdentifierOffsets.empty()) {
+        npc(usage)->addHeap("inflection pattern identifier table", patternIdentifiers.capacity() * sizeof(patternIdentifiers[0])
+            + patternIdentifierOffsets.capacity() * sizeof(patternIdentifierOffsets[0]));
+    }
+    if (!decodedSuffixOffsets.empty()) {
+        npc(usage)->addHeap("inflection suffix table", decodedSuffixes.capacity() * sizeof(decodedSuffixes[0])
+            + decodedSuffixOffsets.capacity() * sizeof(decodedSuffixOffsets[0]));
+    }
+    if (inflectionIndexesBuilt.load(::std::memory_order_acquire)) {
+        npc(usage)->addHeap("inflection grammeme index", inflectionGrammemeIndex.capacity() * sizeof(inflectionGrammemeIndex[0])
+            + inflectionSuffixIndex.capacity() * sizeof(inflectionSuffixIndex[0])
+            + inflectionIndexOffsets.capacity() * sizeof(inflectionIndexOffsets[0])
+            + inflectionSuffixMaxLengths.capacity() * sizeof(inflectionSuffixMaxLengths[0]));
+    }
+}
+
 Inflector_InflectionPattern Inflector_MMappedDictionary::getInflectionPattern(int32_t index) const {
     auto patternIndex = identifierToInflectionPatternTrie.find(index);
     uint64_t inflectionPatternPrefix = inflectionsArray.read(patternIndex);
@@ -100,16 +279,39 @@ Inflector_InflectionPattern Inflector_MMappedDictionary::getInflectionPattern(in
     );
 }
 
-bool Inflector_MMappedDictionary::getInflectionPatternIdentifiers(std::vector<int32_t>& inflectionIdentifiers, std::u16string_view word) const {
-    auto exists = dictionary.getWordPropertyInternalIdentifiers(inflectionIdentifiers, word, dictionary.inflectionKeyIdentifier) != DictionaryMetaData_MMappedDictionary::UNKNOWN;
-    if (!exists && !inflection::util::StringViewUtils::isAllLowerCase(word)) {
-        ::std::u16string normalized;
-        DictionaryMetaData::transform(&normalized, word, locale);
-        if (normalized != word) {
-            exists = dictionary.getWordPropertyInternalIdentifiers(inflectionIdentifiers, normalized, dictionary.inflectionKeyIdentifier) != DictionaryMetaData_MMappedDictionary::UNKNOWN;
-        }
+bool Inflector_MMappedDictionary::getLowercaseInflectionPatternIdentifiersRange(int32_t* offset, int32_t* length, std::u16string_view word) const {
+    if (!dictionary.needsLowercaseRetry(word)) {
+        return false;
     }
-    return exists;
+    ::std::u16string normalized;
+    DictionaryMetaData::transform(&normalized, word, locale);
+    if (normalized == word) {
+        return false;
+    }
+    return dictionary.getWordPropertyValuesRange(offset, length, dictionary.findWordData(normalized), dictionary.inflectionKeyIdentifier) != DictionaryMetaData_MMappedDictionary::UNKNOWN;
+}
+
+bool Inflector_MMappedDictionary::getInflectionPatternIdentifiersRange(int32_t* offset, int32_t* length, std::u16string_view word) const {
+    *npc(offset) = 0;
+    *npc(length) = 0;
+    if (dictionary.getWordPropertyValuesRange(offset, length, dictionary.findWordData(word), dictionary.inflectionKeyIdentifier) != DictionaryMetaData_MMappedDictionary::UNKNOWN) {
+        return true;
+    }
+    return getLowercaseInflectionPatternIdentifiersRange(offset, length, word);
+}
+
+bool Inflector_MMappedDictionary::getInflectionPatternIdentifiersRange(int32_t* offset, int32_t* length, std::string_view word) const {
+    *npc(offset) = 0;
+    *npc(length) = 0;
+    if (dictionary.getWordPropertyValuesRange(offset, length, dictionary.findWordData(word), dictionary.inflectionKeyIdentifier) != DictionaryMetaData_MMappedDictionary::UNKNOWN) {
+        return true;
+    }
+    // Lowercasing is locale sensitive, and it is done in UTF-16. The word as is was already missed.
+    return getLowercaseInflectionPatternIdentifiersRange(offset, length, inflection::util::StringViewUtils::to_u16string(word));
+}
+
+int32_t Inflector_MMappedDictionary::getInflectionPatternIdentifierAt(int32_t offset) const {
+    return dictionary.propertyValueMaps.read(offset);
 }
 
 } // namespace inflection::dictionary
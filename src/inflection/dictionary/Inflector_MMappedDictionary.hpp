@@ -10,17 +10,36 @@
 #include <inflection/dictionary/metadata/StringContainer.hpp>
 #include <inflection/dictionary/metadata/MarisaTrie.hpp>
 #include <inflection/dictionary/Inflector_InflectionPattern.hpp>
+#include <atomic>
+#include <mutex>
 #include <optional>
 
 /*
  * This class is a memory-mapped-backed replacement for Inflector_InflectionDictionary
  */
-class inflection::dictionary::Inflector_MMappedDictionary final {
+class INFLECTION_INTERNAL_API inflection::dictionary::Inflector_MMappedDictionary final {
 public:
     // 7 bytes + null terminator
     static constexpr int64_t VERSION { 4 }; // Bump this version if the binary file format changes.
     static constexpr int16_t ENDIANNESS_MARKER = 1;
     static constexpr int16_t OPTIONS = {  }; // Space reserved for future options. Also used to align data structures after this header. Ideally align to 8 byte boundaries for 64-bit CPU architectures.
+    enum class OptionBits {
+        /**
+         * Decode all of the inflection pattern identifiers when the dictionary is loaded,
+         * so that identifier lookups don't need a trie reverse lookup.
+         */
+        MATERIALIZE_PATTERN_IDENTIFIERS = 1,
+        /**
+         * Index the inflections of each inflection pattern by their grammemes and by their suffixes the first time that
+         * an inflection with an exact set of grammemes is searched, so that the search is a binary search instead of a scan.
+         */
+        INDEX_INFLECTION_GRAMMEMES = 2,
+        /**
+         * Decode all of the inflection suffixes when the dictionary is loaded,
+         * so that reading the suffix of an inflection doesn't need a trie reverse lookup.
+         */
+        DECODE_INFLECTION_SUFFIXES = 4,
+    };
     static constexpr const char16_t * const INFLECTION_KEY = u"inflection";
 
 public:
@@ -35,10 +54,60 @@ public:
 public:
     std::optional<int16_t> getInflectionPatternIndexFromName(std::u16string_view name) const;
     Inflector_InflectionPattern getInflectionPattern(int32_t index) const;
-    bool getInflectionPatternIdentifiers(std::vector<int32_t>& inflectionIdentifiers, std::u16string_view word) const;
+    /**
+     * Find the inflection pattern ids of the word without copying them. Read each one with
+     * getInflectionPatternIdentifierAt(offset + i) for i in [0, length).
+     * @return false when the word is not in the dictionary.
+     */
+    bool getInflectionPatternIdentifiersRange(int32_t* offset, int32_t* length, std::u16string_view word) const;
+    bool getInflectionPatternIdentifiersRange(int32_t* offset, int32_t* length, std::string_view word) const;
+    int32_t getInflectionPatternIdentifierAt(int32_t offset) const;
+    /**
+     * Get the identifier of the inflection pattern with the given id.
+     * When the identifiers are materialized, the returned view points into this dictionary and buffer is unused.
+     * Otherwise the identifier is decoded into buffer, and the returned view points into buffer.
+     */
+    ::std::u16string_view getInflectionPatternIdentifier(::std::u16string* buffer, int32_t id) const;
+    void appendInflectionPatternIdentifier(::std::u16string* dest, int32_t id) const;
+    /**
+     * Get the inflection suffix with the given id.
+     * When the suffixes are decoded, the returned view points into this dictionary and buffer is unused.
+     * Otherwise the suffix is decoded into buffer, and the returned view points into buffer.
+     */
+    ::std::u16string_view getInflectionSuffix(::std::u16string* buffer, int32_t id) const;
+    void appendInflectionPatternIdentifier(::std::string* dest, int32_t id) const;
+    /**
+     * Append the words that inflect from the lemma with the inflection pattern of the given id to the result.
+     * @return false when the dictionary has no lemma index.
+     */
+    bool getWordsForLemma(::std::vector<::std::u16string>* result, std::u16string_view lemma, int32_t inflectionPatternId) const;
+    bool hasInflectionGrammemeIndex() const;
+    /**
+     * Find the first inflection of the inflection pattern with the given id that has exactly the given grammemes.
+     * @return the position of the inflection in the pattern, or -1 when there is no such inflection or when the grammemes are not indexed.
+     */
+    int32_t findInflectionPositionWithGrammemes(int32_t inflectionPatternId, int64_t grammemes) const;
+    /**
+     * Find the longest suffix of the surface form that is the suffix of an inflection of the inflection pattern with the
+     * given id. Only the inflections with grammemes that are all in fromGrammemes are considered, unless fromGrammemes is 0.
+     * @return the length of the suffix, or 0 when there is no such inflection. This is -1 when the grammemes are not indexed.
+     */
+    int32_t findLongestInflectionSuffixLength(int32_t inflectionPatternId, int64_t fromGrammemes, ::std::u16string_view surfaceForm) const;
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage) const;
 
 private:
+    /**
+     * Look up the lowercase form of a word that was not found as is.
+     */
+    bool getLowercaseInflectionPatternIdentifiersRange(int32_t* offset, int32_t* length, std::u16string_view word) const;
+    /**
+     * Build the inflection indexes when the grammemes are indexed and they were not built yet.
+     * @return false when the grammemes are not indexed.
+     */
+    bool buildInflectionIndexes() const;
+
     const inflection::util::ULocale locale;
+    int16_t options {  };
 
     int32_t grammemePatternsSize {  };
     const int64_t *grammemePatterns {  };
@@ -65,6 +134,31 @@ private:
     const int32_t *frequenciesArray {  };
 
     inflection::dictionary::metadata::MarisaTrie<int32_t> identifierToInflectionPatternTrie;
+    // When materialized, all identifiers are concatenated, and identifier id spans [offsets[id], offsets[id + 1]).
+    ::std::u16string patternIdentifiers {  };
+    ::std::vector<int32_t> patternIdentifierOffsets {  };
+    // When decoded, evaluating a pattern does not do a trie reverse lookup for each inflection.
+    // The suffix id spans [offsets[id], offsets[id + 1]).
+    ::std::u16string decodedSuffixes {  };
+    ::std::vector<int32_t> decodedSuffixOffsets {  };
+    struct InflectionGrammemeIndexEntry {
+        int64_t grammemes;
+        int32_t position;
+    };
+    struct InflectionSuffixIndexEntry {
+        int64_t grammemes;
+        int32_t suffixId;
+    };
+    // The indexes are built by the first search that needs them, and they are read only after that.
+    mutable ::std::once_flag inflectionIndexesOnce {  };
+    mutable ::std::atomic<bool> inflectionIndexesBuilt { false };
+    // The inflections of pattern id span [offsets[id], offsets[id + 1]) in both indexes. In the grammeme index, they are
+    // sorted by grammemes and then by position. In the suffix index, they are sorted by suffix id.
+    mutable ::std::vector<InflectionGrammemeIndexEntry> inflectionGrammemeIndex {  };
+    mutable ::std::vector<InflectionSuffixIndexEntry> inflectionSuffixIndex {  };
+    mutable ::std::vector<int32_t> inflectionIndexOffsets {  };
+    // The length of the longest suffix of each pattern, which bounds the suffixes of a surface form that are searched.
+    mutable ::std::vector<int32_t> inflectionSuffixMaxLengths {  };
 
     friend class DictionaryMetaData_MMappedDictionary;
     friend class Inflector_InflectionPattern;
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include <inflection/dictionary/Inflector_Paradigm.hpp>
+
+#include <inflection/exception/IndexOutOfBoundsException.hpp>
+
+namespace inflection::dictionary {
+
+Inflector_Paradigm::Inflector_Paradigm() = default;
+
+Inflector_Paradigm::~Inflector_Paradigm() = default;
+
+void Inflector_Paradigm::clear()
+{
+    surfaceForms.clear();
+    forms.clear();
+    patternIdentifiers.clear();
+    patterns.clear();
+}
+
+int32_t Inflector_Paradigm::size() const
+{
+    return int32_t(forms.size());
+}
+
+bool Inflector_Paradigm::empty() const
+{
+    return forms.empty();
+}
+
+int64_t Inflector_Paradigm::getGrammemes(int32_t index) const
+{
+    if (index < 0 || index >= size()) {
+        throw ::inflection::exception::IndexOutOfBoundsException(u"Invalid paradigm index");
+    }
+    return forms[index].grammemes;
+}
+
+::std::u16string_view Inflector_Paradigm::getSurfaceForm(int32_t index) const
+{
+    if (index < 0 || index >= size()) {
+        throw ::inflection::exception::IndexOutOfBoundsException(u"Invalid paradigm index");
+    }
+    const auto& surfaceForm = forms[index].surfaceForm;
+    return ::std::u16string_view(surfaceForms).substr(surfaceForm.start, surfaceForm.length);
+}
+
+int32_t Inflector_Paradigm::getPatternIndex(int32_t index) const
+{
+    if (index < 0 || index >= size()) {
+        throw ::inflection::exception::IndexOutOfBoundsException(u"Invalid paradigm index");
+    }
+    return forms[index].pattern;
+}
+
+int32_t Inflector_Paradigm::getPatternCount() const
+{
+    return int32_t(patterns.size());
+}
+
+::std::u16string_view Inflector_Paradigm::getPatternIdentifier(int32_t patternIndex) const
+{
+    if (patternIndex < 0 || patternIndex >= getPatternCount()) {
+        throw ::inflection::exception::IndexOutOfBoundsException(u"Invalid paradigm pattern index");
+    }
+    const auto& pattern = patterns[patternIndex];
+    return ::std::u16string_view(patternIdentifiers).substr(pattern.start, pattern.length);
+}
+
+void Inflector_Paradigm::addPattern(::std::u16string_view identifier)
+{
+    patterns.push_back({int32_t(patternIdentifiers.length()), int32_t(identifier.length())});
+    patternIdentifiers.append(identifier);
+}
+
+void Inflector_Paradigm::add(int64_t grammemes, ::std::u16string_view stem, ::std::u16string_view suffix)
+{
+    const auto start = int32_t(surfaceForms.length());
+    surfaceForms.append(stem);
+    surfaceForms.append(suffix);
+    forms.push_back({grammemes, getPatternCount() - 1, {start, int32_t(surfaceForms.length()) - start}});
+}
+
+} // namespace inflection::dictionary
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/dictionary/fwd.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * The surface forms of a lemma with their grammemes, as generated from its inflection patterns.
+ * A lemma can have several inflection patterns, such as one for each part of speech, so each form records the pattern
+ * that generated it. The forms of a pattern are contiguous, in the order of the pattern.
+ * All of the forms share one buffer, so a paradigm that is cleared and reused does not allocate once it is large enough.
+ */
+class INFLECTION_INTERNAL_API inflection::dictionary::Inflector_Paradigm final
+{
+public:
+    /**
+     * Remove all of the forms, and keep the memory for the next paradigm.
+     */
+    void clear();
+    int32_t size() const;
+    bool empty() const;
+    int64_t getGrammemes(int32_t index) const;
+    /**
+     * The returned view is valid until the paradigm is modified.
+     */
+    ::std::u16string_view getSurfaceForm(int32_t index) const;
+    /**
+     * The index of the inflection pattern that generated the form, for getPatternIdentifier.
+     */
+    int32_t getPatternIndex(int32_t index) const;
+    int32_t getPatternCount() const;
+    /**
+     * The returned view is valid until the paradigm is modified.
+     */
+    ::std::u16string_view getPatternIdentifier(int32_t patternIndex) const;
+
+private:
+    void addPattern(::std::u16string_view identifier);
+    void add(int64_t grammemes, ::std::u16string_view stem, ::std::u16string_view suffix);
+
+    struct Span {
+        int32_t start;
+        int32_t length;
+    };
+    struct Form {
+        int64_t grammemes;
+        int32_t pattern;
+        Span surfaceForm;
+    };
+    ::std::u16string surfaceForms {  };
+    ::std::vector<Form> forms {  };
+    ::std::u16string patternIdentifiers {  };
+    ::std::vector<Span> patterns {  };
+    /**
+     * Reused by the inflection patterns for decoding suffixes and identifiers that are not stored in the dictionary as is.
+     */
+    ::std::u16string decodingBuffer {  };
+
+public:
+    Inflector_Paradigm();
+    ~Inflector_Paradigm();
+
+private:
+    friend class Inflector_InflectionPattern;
+};
@@ -20,6 +20,7 @@ namespace inflection
         class Inflector_Inflection;
         class Inflector_InflectionPattern;
         class Inflector_MMappedDictionary;
+        class Inflector_Paradigm;
         class PhraseProperties;
         /// @endcond
     } // dictionary
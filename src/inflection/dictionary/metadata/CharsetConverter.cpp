@@ -1,19 +1,66 @@
 /*
  * Copyright 2017-2024 Apple Inc. All rights reserved.
  */
-// Ignore the deprecation warning around ucnv_safeClone
-#include <unicode/umachine.h>
-#undef U_DEPRECATED
-#define U_DEPRECATED U_CAPI
-
 #include <inflection/dictionary/metadata/CharsetConverter.hpp>
 
 #include <inflection/exception/ICUException.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/npc.hpp>
+#include <unicode/ustring.h>
+#include <cstring>
+#include <utility>
+#include <vector>
 
 namespace inflection::dictionary::metadata {
 
+namespace {
+
+/**
+ * The stateful converters cloned for the current thread, one per encoding.
+ * ucnv_fromUChars and ucnv_toUChars reset the converter state before converting,
+ * so a clone can be reused for every call on the same thread.
+ */
+class ThreadLocalConverters {
+public:
+    ThreadLocalConverters() = default;
+    ~ThreadLocalConverters()
+    {
+        for (const auto& [name, converter] : converters) {
+            ucnv_close(converter);
+        }
+    }
+
+    UConverter* get(const UConverter* prototype)
+    {
+        auto status = U_ZERO_ERROR;
+        const char* name = ucnv_getName(prototype, &status);
+        inflection::exception::ICUException::throwOnFailure(status, u"Could not get converter name");
+        for (const auto& [convertersName, converter] : converters) {
+            if (strcmp(convertersName.c_str(), name) == 0) {
+                return converter;
+            }
+        }
+        auto localConverter = ucnv_clone(prototype, &status);
+        inflection::exception::ICUException::throwOnFailure(status, u"Could not clone converter");
+        converters.emplace_back(name, localConverter);
+        return localConverter;
+    }
+
+private:
+    ::std::vector<::std::pair<::std::string, UConverter*>> converters {  };
+
+    ThreadLocalConverters(const ThreadLocalConverters&) = delete;
+    ThreadLocalConverters& operator=(const ThreadLocalConverters&) = delete;
+};
+
+static UConverter* getThreadConverter(const UConverter* prototype)
+{
+    static thread_local ThreadLocalConverters threadConverters;
+    return threadConverters.get(prototype);
+}
+
+}
+
 CharsetConverter::CharsetConverter(const char* encoding)
 {
     auto errorCode = U_ZERO_ERROR;
@@ -44,10 +91,7 @@ void CharsetConverter::encode(::std::string* out, std::u16string_view str) const
     }
     else {
         auto status = U_ZERO_ERROR;
-        char converterBuffer[U_CNV_SAFECLONE_BUFFERSIZE];
-        int32_t converterLength = sizeof(converterBuffer);
-        auto localConverter = ucnv_safeClone(converter, converterBuffer, &converterLength, &status);
-        inflection::exception::ICUException::throwOnFailure(status, u"Could not clone converter");
+        auto localConverter = getThreadConverter(converter);
 
         int32_t inputLength = int32_t(str.length());
         constexpr uint8_t PADDING = 8; // + padding for possible shift state
@@ -70,38 +114,45 @@ void CharsetConverter::encode(::std::string* out, std::u16string_view str) const
             // length got updated with the correct size, so redo
         }
 
-        ucnv_close(localConverter);
         inflection::exception::ICUException::throwOnFailure(status, u"Conversion failed");
     }
 }
 
 void CharsetConverter::decode(::std::u16string* out, const char* str, int32_t length) const
 {
-    if (converterType == UCNV_UTF8) {
-        inflection::util::StringViewUtils::convert(out, std::string_view(str, length));
+    npc(out)->clear();
+    decodeAppend(out, str, length);
+}
+
+void CharsetConverter::decodeAppend(::std::u16string* out, const char* str, int32_t length) const
+{
+    const auto offset = npc(out)->length();
+    if (converterType == UCNV_UTF16_LittleEndian && !U_IS_BIG_ENDIAN && (length % sizeof(char16_t)) == 0) {
+        out->append((const char16_t*)str, length / sizeof(char16_t));
     }
-    else if (converterType == UCNV_UTF16_LittleEndian && !U_IS_BIG_ENDIAN && (length % sizeof(char16_t)) == 0) {
-        const auto outLen = length / sizeof(char16_t);
-        npc(out)->resize(outLen, 0);
-        npc(out)->assign((const char16_t*)str, outLen);
+    else if (converterType == UCNV_UTF8) {
+        // UTF-8 never decodes to more code units than it has bytes.
+        auto status = U_ZERO_ERROR;
+        int32_t outLength = 0;
+        out->resize(offset + length, 0);
+        u_strFromUTF8WithSub((UChar *) out->data() + offset, length, &outLength, str, length, U_SENTINEL, nullptr, &status);
+        out->resize(offset + outLength);
+        inflection::exception::ICUException::throwOnFailure(status, u"Conversion failed");
     }
     else {
         auto status = U_ZERO_ERROR;
-        char converterBuffer[U_CNV_SAFECLONE_BUFFERSIZE];
-        int32_t converterLength = sizeof(converterBuffer);
-        auto localConverter = ucnv_safeClone(converter, converterBuffer, &converterLength, &status);
-        inflection::exception::ICUException::throwOnFailure(status, u"Could not clone converter");
+        auto localConverter = getThreadConverter(converter);
 
         auto inputLength = length;
 
-        npc(out)->resize(length, 0);
+        out->resize(offset + length, 0);
         // attempt to convert with a best guess buffer length.
         // if necessary, increase buffer and re-run
         for (int32_t i = 0; i < 2; ++i) {
             status = U_ZERO_ERROR;
-            length = ucnv_toUChars(localConverter, (UChar *) &((*out)[0]), length, str,
+            length = ucnv_toUChars(localConverter, (UChar *) out->data() + offset, length, str,
                                    inputLength, &status);
-            npc(out)->resize(length, 0);
+            out->resize(offset + length, 0);
             if (status != U_BUFFER_OVERFLOW_ERROR) {
                 break;
             }
@@ -109,9 +160,25 @@ void CharsetConverter::decode(::std::u16string* out, const char* str, int32_t le
             // This is normally impossible to hit.
         }
 
-        ucnv_close(localConverter);
         inflection::exception::ICUException::throwOnFailure(status, u"Conversion failed");
     }
 }
 
+void CharsetConverter::decodeAppend(::std::string* out, const char* str, int32_t length) const
+{
+    if (converterType == UCNV_UTF8) {
+        npc(out)->append(str, length);
+    }
+    else {
+        ::std::u16string decoded;
+        decodeAppend(&decoded, str, length);
+        npc(out)->append(inflection::util::StringViewUtils::to_string(decoded));
+    }
+}
+
+bool CharsetConverter::isUTF8() const
+{
+    return converterType == UCNV_UTF8;
+}
+
 } // namespace inflection::dictionary::metadata
@@ -17,6 +17,12 @@ public:
 
     void encode(::std::string* out, std::u16string_view str) const;
     void decode(::std::u16string* out, const char* str, int32_t length) const;
+    /** Like decode, but the result is appended to the existing contents of out. */
+    void decodeAppend(::std::u16string* out, const char* str, int32_t length) const;
+    /** Like decode, but the result is appended to out as UTF-8. This is a plain copy when the encoding is already UTF-8. */
+    void decodeAppend(::std::string* out, const char* str, int32_t length) const;
+    /** Returns true when the encoded form is UTF-8, which means UTF-8 input can be used without any conversion. */
+    bool isUTF8() const;
     ~CharsetConverter() override;
 
 private:
@@ -7,10 +7,12 @@
 #include <inflection/dictionary/metadata/fwd.hpp>
 #include <inflection/exception/IndexOutOfBoundsException.hpp>
 #include <inflection/util/MemoryMappedFile.hpp>
+#include <inflection/util/MemoryUsage.hpp>
 #include <inflection/npc.hpp>
 #include <cstring>
 #include <memory>
 #include <sstream>
+#include <string_view>
 #include <iosfwd>
 #include <vector>
 
@@ -25,9 +27,15 @@ public:
     bool isEmpty() const;
 
     T read(int32_t index) const;
+    /**
+     * Read the values from startIndex to startIndex + length into result, which must have room for length values.
+     * The range is validated once, and the values are extracted sequentially from the packed words.
+     */
+    void readRange(T* result, int32_t startIndex, int32_t length) const;
     void write(int32_t index, T value);
 
     void serialize(std::ostream &writer) const;
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const;
 
     explicit CompressedArray(::inflection::util::MemoryMappedFile* mappedFile);
     CompressedArray(int32_t wordWidth, int32_t arraySize);
@@ -141,6 +149,35 @@ T inflection::dictionary::metadata::CompressedArray<T>::read(int32_t index) cons
     return ((T) retVal);
 }
 
+template <typename T>
+void inflection::dictionary::metadata::CompressedArray<T>::readRange(T* result, int32_t startIndex, int32_t length) const {
+    if (length <= 0) {
+        return;
+    }
+    int64_t startBitPos = int64_t(startIndex) * wordWidth;
+    int64_t endBitPos = startBitPos + int64_t(length) * wordWidth;
+    if (startIndex < 0 || endBitPos > int64_t(dataArrayLength) * DATAWIDTH) {
+        throw inflection::exception::IndexOutOfBoundsException(u"Invalid CompressedArray range");
+    }
+
+    const uint64_t* currData = data + (startBitPos / DATAWIDTH);
+    int32_t shiftStart = int32_t(startBitPos % DATAWIDTH);
+    for (int32_t idx = 0; idx < length; idx++) {
+        uint64_t value = *currData >> shiftStart;
+        int32_t shiftEnd = shiftStart + wordWidth;
+        if (shiftEnd > DATAWIDTH) {
+            // The value straddles two words. shiftStart can't be 0 here.
+            value |= currData[1] << (DATAWIDTH - shiftStart);
+        }
+        if (shiftEnd >= DATAWIDTH) {
+            currData++;
+            shiftEnd -= DATAWIDTH;
+        }
+        shiftStart = shiftEnd;
+        result[idx] = T(value & selectMask);
+    }
+}
+
 template <typename T>
 void inflection::dictionary::metadata::CompressedArray<T>::write(int32_t index, T value) {
     uint64_t unsignedVal = (uint64_t) value;
@@ -160,6 +197,18 @@ void inflection::dictionary::metadata::CompressedArray<T>::write(int32_t index,
     }
 }
 
+template <typename T>
+void inflection::dictionary::metadata::CompressedArray<T>::addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const
+{
+    const size_t dataSize = sizeof(data[0]) * dataArrayLength;
+    if (ownData) {
+        npc(usage)->addHeap(name, dataSize);
+    }
+    else {
+        npc(usage)->addMapped(name, data, dataSize);
+    }
+}
+
 template <typename T>
 void inflection::dictionary::metadata::CompressedArray<T>::serialize(::std::ostream& writer) const
 {
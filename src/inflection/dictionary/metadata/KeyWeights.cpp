@@ -0,0 +1,70 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include <inflection/dictionary/metadata/KeyWeights.hpp>
+
+#include <inflection/exception/IOException.hpp>
+#include <inflection/util/StringViewUtils.hpp>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+
+namespace inflection::dictionary::metadata {
+
+KeyWeights::KeyWeights(const ::std::string& path)
+{
+    ::std::ifstream input(path);
+    if (!input) {
+        throw ::inflection::exception::IOException(u"Unable to read the key weights file " + ::inflection::util::StringViewUtils::to_u16string(path));
+    }
+    ::std::string line;
+    ::std::u16string key;
+    int32_t lineNumber = 0;
+    while (::std::getline(input, line)) {
+        lineNumber++;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+        auto separator = line.rfind('\t');
+        double count = 0;
+        char* countEnd = nullptr;
+        if (separator != ::std::string::npos && separator + 1 < line.length() && !::std::isspace((unsigned char)line[separator + 1])) {
+            // strtod is used instead of from_chars because not every supported standard library parses floating point with from_chars.
+            count = ::std::strtod(line.c_str() + separator + 1, &countEnd);
+        }
+        if (countEnd != line.c_str() + line.length() || !::std::isfinite(count) || count < 0) {
+            throw ::inflection::exception::IOException(u"Invalid count on line " + ::inflection::util::StringViewUtils::to_u16string(::std::to_string(lineNumber)) + u" of " + ::inflection::util::StringViewUtils::to_u16string(path));
+        }
+        ::inflection::util::StringViewUtils::convert(&key, ::std::string_view(line.data(), separator));
+        weights.try_emplace(key, DEFAULT_WEIGHT).first->second += float(count);
+    }
+}
+
+KeyWeights::KeyWeights(const ::std::map<::std::u16string, float, ::std::less<>>& weights)
+    : weights(weights)
+{
+}
+
+KeyWeights::~KeyWeights()
+{
+}
+
+float KeyWeights::getWeight(::std::u16string_view key) const
+{
+    auto result = weights.find(key);
+    if (result == weights.end()) {
+        return DEFAULT_WEIGHT;
+    }
+    return result->second;
+}
+
+int32_t KeyWeights::size() const
+{
+    return int32_t(weights.size());
+}
+
+} // namespace inflection::dictionary::metadata
@@ -0,0 +1,41 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/dictionary/metadata/fwd.hpp>
+#include <map>
+#include <string>
+#include <string_view>
+
+/**
+ * The weights of the keys of a MarisaTrie while it is built. A key with a larger weight gets a shorter path near the
+ * start of the trie, which makes looking up the frequently used keys touch fewer cache lines. The weights only change
+ * the layout of the trie, and not the serialized format.
+ */
+class INFLECTION_INTERNAL_API inflection::dictionary::metadata::KeyWeights final {
+public:
+    /** The weight of a key that has no weight. */
+    static constexpr float DEFAULT_WEIGHT = 1.0f;
+
+    /** Returns the weight of the key, or DEFAULT_WEIGHT when the key has no weight. */
+    float getWeight(::std::u16string_view key) const;
+    /** Returns the number of keys with a weight. */
+    int32_t size() const;
+
+    /**
+     * Read a UTF-8 file with a key, a tab and a count on each line, such as word counts from usage logs.
+     * Empty lines and lines that start with # are ignored. The weight of a key is DEFAULT_WEIGHT plus its count, and
+     * the counts of a repeated key are added together.
+     * @throws IOException when the file can not be read, or a line does not have a valid count.
+     */
+    explicit KeyWeights(const ::std::string& path);
+    explicit KeyWeights(const ::std::map<::std::u16string, float, ::std::less<>>& weights);
+    ~KeyWeights();
+
+private:
+    ::std::map<::std::u16string, float, ::std::less<>> weights {  };
+
+    KeyWeights(const KeyWeights& other) = delete;
+    KeyWeights& operator=(const KeyWeights& other) = delete;
+};
@@ -6,6 +6,7 @@
 #include <inflection/dictionary/metadata/fwd.hpp>
 #include <inflection/dictionary/metadata/CharsetConverter.hpp>
 #include <inflection/dictionary/metadata/CompressedArray.hpp>
+#include <inflection/dictionary/metadata/KeyWeights.hpp>
 #include <inflection/dictionary/metadata/MarisaTrieIterator.hpp>
 #include <inflection/exception/IllegalStateException.hpp>
 #include <inflection/util/MemoryMappedFile.hpp>
@@ -49,12 +50,47 @@ public:
 
     T find(int32_t id) const;
     std::optional<T> find(std::u16string_view key) const;
+    /**
+     * Like find, but the encoded key is stored in encodedBuffer so that the buffer can be reused between lookups.
+     */
+    std::optional<T> find(std::u16string_view key, ::std::string* encodedBuffer) const;
+    /**
+     * Find a UTF-8 key. No conversion is needed when the trie uses the UTF8 key encoding.
+     */
+    std::optional<T> find(std::string_view key) const;
     int32_t getKeyId(std::u16string_view key) const;
+    int32_t getKeyId(std::u16string_view key, ::std::string* encodedBuffer) const;
+    int32_t getKeyId(std::string_view key) const;
     ::std::u16string getKey(int32_t id) const;
+    /**
+     * Replace the contents of dest with the key, so that the buffer can be reused between reverse lookups.
+     * @return The length of the key.
+     */
+    int32_t getKey(::std::u16string* dest, int32_t id) const;
+    void appendKey(::std::u16string* dest, int32_t id) const;
+    void appendKey(::std::string* dest, int32_t id) const;
 
     inflection::dictionary::metadata::MarisaTrieIterator<T> getAllWithPrefix(std::u16string_view prefix) const;
+    /**
+     * Iterate over the keys with an id in [beginId, endId), in key id order instead of key order.
+     */
+    inflection::dictionary::metadata::MarisaTrieIterator<T> getAllInKeyIdRange(int32_t beginId, int32_t endId) const;
+    /**
+     * Call callback(key, value) for each non-empty key that starts with the prefix. The key is decoded into keyBuffer,
+     * and the view of it is only valid during the callback. Iteration stops when the callback returns false.
+     */
+    template <typename Callback>
+    void forEachWithPrefix(std::u16string_view prefix, ::std::u16string* keyBuffer, Callback&& callback) const;
+    /**
+     * Call callback(key, value) for each key that is a prefix of the text, from the shortest key to the longest.
+     * The key is decoded into keyBuffer, and the view of it is only valid during the callback.
+     * Iteration stops when the callback returns false.
+     */
+    template <typename Callback>
+    void forEachPrefixOf(std::u16string_view text, ::std::u16string* keyBuffer, Callback&& callback) const;
 
     int32_t getSize() const;
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const;
 
     static constexpr int32_t alignedTrieSize(int32_t size) {
         return size + ((sizeof(int64_t) - (size % sizeof(int64_t))) % sizeof(int64_t));
@@ -63,6 +99,20 @@ public:
     void write(::std::ostream& writer) const;
 
     explicit MarisaTrie(const ::std::map<::std::u16string_view, T>& input);
+    /**
+     * Use the given key encoding instead of the most compact one.
+     */
+    MarisaTrie(const ::std::map<::std::u16string_view, T>& input, EncodingEnum keyEncoding);
+    /**
+     * Lay out the trie so that the keys with a larger weight are faster to look up. The format is the same as an
+     * unweighted trie, but the key ids are different.
+     * @param keyWeights The weights of the keys. Null builds an unweighted trie.
+     */
+    MarisaTrie(const ::std::map<::std::u16string_view, T>& input, const KeyWeights* keyWeights);
+    /**
+     * Use the given key encoding, and lay out the trie with the key weights.
+     */
+    MarisaTrie(const ::std::map<::std::u16string_view, T>& input, EncodingEnum keyEncoding, const KeyWeights* keyWeights);
     explicit MarisaTrie(::inflection::util::MemoryMappedFile* mappedFile);
     ~MarisaTrie();
 
@@ -72,6 +122,8 @@ private:
     CompressedArray<T> data;
     int16_t encodingEnum {  };
     uint16_t options {  };
+    const char* mappedTrieData {  };
+    int32_t mappedTrieSize {  };
 
     typedef struct FieldMetrics {
         EncodingEnum keyEncoding {  };
@@ -80,7 +132,7 @@ private:
     /** When you get over 128K entries, sample a minimum of 64K entries */
     static constexpr uint32_t SHIFT_AMOUNT_FOR_SKIPPING = 17;
 
-    MarisaTrie(const ::std::map<::std::u16string_view, T>& input, FieldMetrics fieldMetrics);
+    MarisaTrie(const ::std::map<::std::u16string_view, T>& input, FieldMetrics fieldMetrics, const KeyWeights* keyWeights);
     MarisaTrie(::inflection::util::MemoryMappedFile* mappedFile, int32_t trieSize);
     MarisaTrie(::inflection::util::MemoryMappedFile* mappedFile, int32_t trieSize, EncodingEnum encodingEnum);
     MarisaTrie(::inflection::util::MemoryMappedFile* mappedFile, int32_t trieSize, EncodingEnum encodingEnum, uint16_t options);
@@ -88,13 +140,14 @@ private:
     MarisaTrie& operator=(const MarisaTrie& other) = delete;
 
     static inline FieldMetrics getFieldMetrics(const ::std::map<::std::u16string_view, T>& input);
+    static ::marisa::Agent& getLookupAgent();
 
     friend class MarisaTrieIterator<T>;
     friend class StringContainer;
 };
 
 template <typename T>
-inflection::dictionary::metadata::MarisaTrie<T>::MarisaTrie(const ::std::map<::std::u16string_view, T>& input, FieldMetrics fieldMetrics)
+inflection::dictionary::metadata::MarisaTrie<T>::MarisaTrie(const ::std::map<::std::u16string_view, T>& input, FieldMetrics fieldMetrics, const KeyWeights* keyWeights)
     : encoder(getEncodingName(fieldMetrics.keyEncoding))
     , data(fieldMetrics.wordWidth, int32_t(input.size()))
     , encodingEnum(fieldMetrics.keyEncoding)
@@ -105,8 +158,9 @@ inflection::dictionary::metadata::MarisaTrie<T>::MarisaTrie(const ::std::map<::s
     // Create the encoded keys
     for (auto entry : input) {
         encoder.encode(&encoded, entry.first);
-        keyset.push_back(encoded.data(), encoded.length());
+        keyset.push_back(encoded.data(), encoded.length(), keyWeights == nullptr ? KeyWeights::DEFAULT_WEIGHT : keyWeights->getWeight(entry.first));
     }
+    // The default node order is the weight order, so the heavier keys are checked first.
     trie.build(keyset);
 
     // We iterate over the map again. The Keyset indexes are the same, but the keyset has had its id updated.
@@ -118,7 +172,25 @@ inflection::dictionary::metadata::MarisaTrie<T>::MarisaTrie(const ::std::map<::s
 
 template <typename T>
 inflection::dictionary::metadata::MarisaTrie<T>::MarisaTrie(const ::std::map<::std::u16string_view, T>& input)
-    : MarisaTrie(input, getFieldMetrics(input))
+    : MarisaTrie(input, getFieldMetrics(input), nullptr)
+{
+}
+
+template <typename T>
+inflection::dictionary::metadata::MarisaTrie<T>::MarisaTrie(const ::std::map<::std::u16string_view, T>& input, EncodingEnum keyEncoding)
+    : MarisaTrie(input, FieldMetrics{keyEncoding, getFieldMetrics(input).wordWidth}, nullptr)
+{
+}
+
+template <typename T>
+inflection::dictionary::metadata::MarisaTrie<T>::MarisaTrie(const ::std::map<::std::u16string_view, T>& input, const KeyWeights* keyWeights)
+    : MarisaTrie(input, getFieldMetrics(input), keyWeights)
+{
+}
+
+template <typename T>
+inflection::dictionary::metadata::MarisaTrie<T>::MarisaTrie(const ::std::map<::std::u16string_view, T>& input, EncodingEnum keyEncoding, const KeyWeights* keyWeights)
+    : MarisaTrie(input, FieldMetrics{keyEncoding, getFieldMetrics(input).wordWidth}, keyWeights)
 {
 }
 
@@ -132,6 +204,8 @@ inflection::dictionary::metadata::MarisaTrie<T>::MarisaTrie(::inflection::util::
     if (trieSize > 0) {
         const char* rawTrieData = npc(mappedFile)->readArray<char>(trieSize);
         trie.map(rawTrieData, trieSize);
+        mappedTrieData = rawTrieData;
+        mappedTrieSize = trieSize;
     }
     else {
         // Create an empty trie that you can get a valid key iterator.
@@ -218,20 +292,71 @@ template <typename T>
 ::std::u16string inflection::dictionary::metadata::MarisaTrie<T>::getKey(int32_t id) const
 {
     ::std::u16string result;
+    appendKey(&result, id);
+    return result;
+}
+
+template <typename T>
+int32_t inflection::dictionary::metadata::MarisaTrie<T>::getKey(::std::u16string* dest, int32_t id) const
+{
+    npc(dest)->clear();
+    appendKey(dest, id);
+    return int32_t(dest->length());
+}
+
+template <typename T>
+void inflection::dictionary::metadata::MarisaTrie<T>::appendKey(::std::u16string* dest, int32_t id) const
+{
     ::marisa::Agent agent;
     agent.set_query(id);
     trie.reverse_lookup(agent);
-    encoder.decode(&result, agent.key().ptr(), int32_t(agent.key().length()));
-    return result;
+    encoder.decodeAppend(dest, agent.key().ptr(), int32_t(agent.key().length()));
+}
+
+template <typename T>
+void inflection::dictionary::metadata::MarisaTrie<T>::appendKey(::std::string* dest, int32_t id) const
+{
+    ::marisa::Agent agent;
+    agent.set_query(id);
+    trie.reverse_lookup(agent);
+    encoder.decodeAppend(dest, agent.key().ptr(), int32_t(agent.key().length()));
+}
+
+template <typename T>
+::marisa::Agent& inflection::dictionary::metadata::MarisaTrie<T>::getLookupAgent()
+{
+    // An agent allocates its search state on its first search, so each thread reuses one for lookups.
+    static thread_local ::marisa::Agent agent;
+    return agent;
+}
+
+template <typename T>
+int32_t inflection::dictionary::metadata::MarisaTrie<T>::getKeyId(std::string_view key) const
+{
+    if (!encoder.isUTF8()) {
+        return getKeyId(::inflection::util::StringViewUtils::to_u16string(key));
+    }
+    auto& agent = getLookupAgent();
+    agent.set_query(key.data(), key.length());
+    if (!trie.lookup(agent)) {
+        return -1;
+    }
+    return (int32_t)agent.key().id();
 }
 
 template <typename T>
 int32_t inflection::dictionary::metadata::MarisaTrie<T>::getKeyId(std::u16string_view key) const
 {
     ::std::string encoded;
-    ::marisa::Agent agent;
-    encoder.encode(&encoded, key);
-    agent.set_query(encoded.data(), encoded.length());
+    return getKeyId(key, &encoded);
+}
+
+template <typename T>
+int32_t inflection::dictionary::metadata::MarisaTrie<T>::getKeyId(std::u16string_view key, ::std::string* encodedBuffer) const
+{
+    auto& agent = getLookupAgent();
+    encoder.encode(encodedBuffer, key);
+    agent.set_query(npc(encodedBuffer)->data(), encodedBuffer->length());
     if (!trie.lookup(agent)) {
         return -1;
     }
@@ -254,6 +379,26 @@ std::optional<T> inflection::dictionary::metadata::MarisaTrie<T>::find(std::u16s
     return data.read(id);
 }
 
+template <typename T>
+std::optional<T> inflection::dictionary::metadata::MarisaTrie<T>::find(std::u16string_view key, ::std::string* encodedBuffer) const
+{
+    auto id = getKeyId(key, encodedBuffer);
+    if (id < 0) {
+        return {};
+    }
+    return data.read(id);
+}
+
+template <typename T>
+std::optional<T> inflection::dictionary::metadata::MarisaTrie<T>::find(std::string_view key) const
+{
+    auto id = getKeyId(key);
+    if (id < 0) {
+        return {};
+    }
+    return data.read(id);
+}
+
 template <typename T>
 void inflection::dictionary::metadata::MarisaTrie<T>::write(::std::ostream& writer) const
 {
@@ -285,8 +430,71 @@ inflection::dictionary::metadata::MarisaTrie<T>::getAllWithPrefix(std::u16string
     return MarisaTrieIterator<T>(*this, prefix);
 }
 
+template <typename T>
+inflection::dictionary::metadata::MarisaTrieIterator<T>
+inflection::dictionary::metadata::MarisaTrie<T>::getAllInKeyIdRange(int32_t beginId, int32_t endId) const
+{
+    return MarisaTrieIterator<T>(*this, beginId, endId);
+}
+
+template <typename T>
+template <typename Callback>
+void inflection::dictionary::metadata::MarisaTrie<T>::forEachWithPrefix(std::u16string_view prefix, ::std::u16string* keyBuffer, Callback&& callback) const
+{
+    ::std::string encodedPrefix;
+    if (!prefix.empty()) {
+        encoder.encode(&encodedPrefix, prefix);
+    }
+    ::marisa::Agent agent;
+    agent.set_query(encodedPrefix.data(), encodedPrefix.length());
+    while (trie.predictive_search(agent)) {
+        encoder.decode(npc(keyBuffer), agent.key().ptr(), int32_t(agent.key().length()));
+        // The empty key is not a word, like in forEachPrefixOf.
+        if (!keyBuffer->empty()
+            && !callback(::std::u16string_view(*keyBuffer), data.read((int32_t) agent.key().id())))
+        {
+            break;
+        }
+    }
+}
+
+template <typename T>
+template <typename Callback>
+void inflection::dictionary::metadata::MarisaTrie<T>::forEachPrefixOf(std::u16string_view text, ::std::u16string* keyBuffer, Callback&& callback) const
+{
+    if (text.empty()) {
+        return;
+    }
+    ::std::string encodedText;
+    encoder.encode(&encodedText, text);
+    ::marisa::Agent agent;
+    agent.set_query(encodedText.data(), encodedText.length());
+    while (trie.common_prefix_search(agent)) {
+        encoder.decode(npc(keyBuffer), agent.key().ptr(), int32_t(agent.key().length()));
+        // A byte prefix of the encoded text is not a prefix of the text when it ends inside of a character.
+        if (!keyBuffer->empty() && text.starts_with(*keyBuffer)
+            && !callback(::std::u16string_view(*keyBuffer), data.read((int32_t) agent.key().id())))
+        {
+            break;
+        }
+    }
+}
+
 template <typename T>
 int32_t inflection::dictionary::metadata::MarisaTrie<T>::getSize() const
 {
     return trie.size();
 }
+
+template <typename T>
+void inflection::dictionary::metadata::MarisaTrie<T>::addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const
+{
+    ::std::string sectionName(name);
+    if (mappedTrieData != nullptr) {
+        npc(usage)->addMapped(sectionName + " trie", mappedTrieData, mappedTrieSize);
+    }
+    else {
+        npc(usage)->addHeap(sectionName + " trie", trie.io_size());
+    }
+    data.addMemoryUsage(usage, sectionName + " values");
+}
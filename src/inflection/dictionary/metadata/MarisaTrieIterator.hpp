@@ -33,10 +33,25 @@ public:
         }
         // else it's an end iterator
     }
+    /**
+     * Iterate over the keys with an id in [beginId, endId), in key id order. Disjoint ranges can be iterated
+     * concurrently, since each iterator has its own agent.
+     */
+    explicit MarisaTrieIterator(const MarisaTrie<T>& trie, int32_t beginId, int32_t endId)
+        : trie(trie)
+        , beginId(beginId)
+        , nextId(beginId)
+        , endId(endId)
+    {
+        operator++();
+    }
     MarisaTrieIterator(MarisaTrieIterator<T>&& iterator)
         : trie(iterator.trie)
         , prefix(iterator.prefix)
         , value(iterator.value)
+        , beginId(iterator.beginId)
+        , nextId(iterator.nextId)
+        , endId(iterator.endId)
         , reachedEnd(iterator.reachedEnd)
     {
         agent.swap(iterator.agent);
@@ -57,6 +72,10 @@ private:
     ::marisa::Agent agent {  };
     ::std::u16string prefix {  };
     ::std::pair<::std::u16string, T> value {  };
+    // The key id range when iterating by key id. A negative endId means a predictive search of the prefix.
+    int32_t beginId { -1 };
+    int32_t nextId { -1 };
+    int32_t endId { -1 };
     bool reachedEnd { false };
 
     friend class inflection::dictionary::DictionaryKeyIterator;
@@ -78,7 +97,16 @@ inflection::dictionary::metadata::MarisaTrieIterator<T>::operator*() {
 template <typename T>
 ::inflection::dictionary::metadata::MarisaTrieIterator<T>&
 inflection::dictionary::metadata::MarisaTrieIterator<T>::operator++() {
-    if (!trie.trie.predictive_search(agent)) {
+    if (endId >= 0) {
+        if (nextId >= endId) {
+            reachedEnd = true;
+        }
+        else {
+            agent.set_query(size_t(nextId++));
+            trie.trie.reverse_lookup(agent);
+        }
+    }
+    else if (!trie.trie.predictive_search(agent)) {
         reachedEnd = true;
     }
     return *this;
@@ -95,6 +123,9 @@ template <typename T>
 inflection::dictionary::metadata::MarisaTrieIterator<T>
 inflection::dictionary::metadata::MarisaTrieIterator<T>::begin() const
 {
+    if (endId >= 0) {
+        return MarisaTrieIterator<T>(trie, beginId, endId);
+    }
     return MarisaTrieIterator<T>(trie, prefix);
 }
 
@@ -102,6 +133,9 @@ template <typename T>
 inflection::dictionary::metadata::MarisaTrieIterator<T>
 inflection::dictionary::metadata::MarisaTrieIterator<T>::end() const
 {
+    if (endId >= 0) {
+        return MarisaTrieIterator<T>(trie, endId, endId);
+    }
     return MarisaTrieIterator<T>(trie, u"\uFFFF");
 }
 
@@ -0,0 +1,153 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include <inflection/dictionary/metadata/MembershipFilter.hpp>
+
+#include <inflection/exception/IOException.hpp>
+#include <inflection/util/MemoryMappedFile.hpp>
+#include <inflection/util/MemoryUsage.hpp>
+#include <inflection/npc.hpp>
+#include <unicode/utf8.h>
+#include <unicode/utf16.h>
+
+namespace inflection::dictionary::metadata {
+
+static constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+static constexpr uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+static inline uint64_t hashCodePoint(uint64_t hash, UChar32 codePoint)
+{
+    return (hash ^ uint64_t(uint32_t(codePoint))) * FNV_PRIME;
+}
+
+static inline uint64_t finalizeHash(uint64_t hash)
+{
+    // The FNV hash is weak in the high bits, which select the block. So mix them.
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+/**
+ * Returns false when the string is not well formed.
+ */
+static bool hashKey(uint64_t* result, ::std::u16string_view key)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    const auto length = int32_t(key.length());
+    for (int32_t idx = 0; idx < length;) {
+        UChar32 codePoint;
+        U16_NEXT(key.data(), idx, length, codePoint);
+        if (U_IS_SURROGATE(codePoint)) {
+            return false;
+        }
+        hash = hashCodePoint(hash, codePoint);
+    }
+    *result = finalizeHash(hash);
+    return true;
+}
+
+static bool hashKey(uint64_t* result, ::std::string_view key)
+{
+    uint64_t hash = FNV_OFFSET_BASIS;
+    const auto length = int32_t(key.length());
+    for (int32_t idx = 0; idx < length;) {
+        UChar32 codePoint;
+        U8_NEXT(key.data(), idx, length, codePoint);
+        if (codePoint < 0) {
+            return false;
+        }
+        hash = hashCodePoint(hash, codePoint);
+    }
+    *result = finalizeHash(hash);
+    return true;
+}
+
+MembershipFilter::MembershipFilter(::inflection::util::MemoryMappedFile* mappedFile)
+    : blockCount(npc(mappedFile)->read<int32_t>())
+    , hashCount(mappedFile->read<int32_t>())
+{
+    if (blockCount <= 0 || hashCount <= 0 || hashCount > HASH_COUNT) {
+        throw ::inflection::exception::IOException(u"Invalid membership filter");
+    }
+    blocks = mappedFile->readArray<const uint64_t>(size_t(blockCount) * WORDS_PER_BLOCK);
+}
+
+MembershipFilter::MembershipFilter(const ::std::set<::std::u16string_view>& keys)
+    : blockCount(int32_t((int64_t(keys.size()) * BITS_PER_KEY + BLOCK_BITS - 1) / BLOCK_BITS))
+    , hashCount(HASH_COUNT)
+{
+    if (blockCount == 0) {
+        blockCount = 1;
+    }
+    ownedBlocks.resize(size_t(blockCount) * WORDS_PER_BLOCK);
+    blocks = ownedBlocks.data();
+    uint64_t hash;
+    for (const auto& key : keys) {
+        if (hashKey(&hash, key)) {
+            add(hash);
+        }
+    }
+}
+
+MembershipFilter::~MembershipFilter()
+{
+}
+
+void MembershipFilter::add(uint64_t hash)
+{
+    auto block = ownedBlocks.data() + ((hash >> 32) * uint64_t(blockCount) >> 32) * WORDS_PER_BLOCK;
+    // Each probe uses 9 bits of a remixed hash to select a bit within the block.
+    auto bits = hash * 0x9e3779b97f4a7c15ULL;
+    for (int32_t probe = 0; probe < hashCount; probe++, bits >>= 9) {
+        auto bit = uint32_t(bits) & (BLOCK_BITS - 1);
+        block[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+}
+
+bool MembershipFilter::mightContainHash(uint64_t hash) const
+{
+    auto block = blocks + ((hash >> 32) * uint64_t(blockCount) >> 32) * WORDS_PER_BLOCK;
+    auto bits = hash * 0x9e3779b97f4a7c15ULL;
+    for (int32_t probe = 0; probe < hashCount; probe++, bits >>= 9) {
+        auto bit = uint32_t(bits) & (BLOCK_BITS - 1);
+        if ((block[bit >> 6] & (uint64_t(1) << (bit & 63))) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MembershipFilter::mightContain(::std::u16string_view key) const
+{
+    uint64_t hash;
+    return !hashKey(&hash, key) || mightContainHash(hash);
+}
+
+bool MembershipFilter::mightContain(::std::string_view key) const
+{
+    uint64_t hash;
+    return !hashKey(&hash, key) || mightContainHash(hash);
+}
+
+void MembershipFilter::write(::std::ostream& output) const
+{
+    output.write(reinterpret_cast<const char*>(&blockCount), sizeof(blockCount));
+    output.write(reinterpret_cast<const char*>(&hashCount), sizeof(hashCount));
+    output.write(reinterpret_cast<const char*>(blocks), ::std::streamsize(size_t(blockCount) * WORDS_PER_BLOCK * sizeof(blocks[0])));
+}
+
+void MembershipFilter::addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const
+{
+    if (ownedBlocks.empty()) {
+        npc(usage)->addMapped(name, blocks, size_t(blockCount) * WORDS_PER_BLOCK * sizeof(blocks[0]));
+    }
+    else {
+        npc(usage)->addHeap(name, ownedBlocks.capacity() * sizeof(ownedBlocks[0]));
+    }
+}
+
+} // namespace inflection::dictionary::metadata
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/dictionary/metadata/fwd.hpp>
+#include <inflection/util/fwd.hpp>
+#include <cstdint>
+#include <ostream>
+#include <set>
+#include <string_view>
+#include <vector>
+
+/**
+ * A blocked Bloom filter of strings. It answers whether a string might be in the set that the filter was built from.
+ * A string that was in the set is never rejected, and most strings that were not in the set are rejected by reading
+ * one cache line. This is checked before a trie lookup so that most words that are not in a dictionary skip the trie.
+ * <p>
+ * The strings are hashed by their code points, so a UTF-8 string and the equivalent UTF-16 string have the same hash.
+ * A string that is not well formed can not be rejected, since a trie may convert it to a replacement character.
+ */
+class INFLECTION_INTERNAL_API inflection::dictionary::metadata::MembershipFilter final {
+public:
+    /** The number of bits per string. This is about a 1% false positive rate. */
+    static constexpr int32_t BITS_PER_KEY = 10;
+    /** The number of bits in a block, which is one cache line. */
+    static constexpr int32_t BLOCK_BITS = 512;
+
+    /** Returns false when the string is definitely not in the set. */
+    bool mightContain(::std::u16string_view key) const;
+    /** Returns false when the UTF-8 string is definitely not in the set. */
+    bool mightContain(::std::string_view key) const;
+
+    void write(::std::ostream& output) const;
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const;
+
+    explicit MembershipFilter(::inflection::util::MemoryMappedFile* mappedFile);
+    explicit MembershipFilter(const ::std::set<::std::u16string_view>& keys);
+    ~MembershipFilter();
+
+private:
+    static constexpr int32_t WORDS_PER_BLOCK = BLOCK_BITS / 64;
+    static constexpr int32_t HASH_COUNT = 7;
+
+    bool mightContainHash(uint64_t hash) const;
+    void add(uint64_t hash);
+
+    int32_t blockCount {  };
+    int32_t hashCount {  };
+    const uint64_t* blocks {  };
+    ::std::vector<uint64_t> ownedBlocks {  };
+
+    MembershipFilter(const MembershipFilter& other) = delete;
+    MembershipFilter& operator=(const MembershipFilter& other) = delete;
+};
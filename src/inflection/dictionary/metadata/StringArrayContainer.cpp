@@ -6,6 +6,7 @@
 #include <inflection/exception/IllegalArgumentException.hpp>
 #include <inflection/exception/IndexOutOfBoundsException.hpp>
 #include <inflection/util/MemoryMappedFile.hpp>
+#include <inflection/util/MemoryUsage.hpp>
 #include <inflection/npc.hpp>
 #include <numeric>
 #include <string.h>
@@ -70,6 +71,18 @@ inflection::dictionary::metadata::StringArrayContainer::~StringArrayContainer()
     }
 }
 
+void inflection::dictionary::metadata::StringArrayContainer::addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const
+{
+    const size_t dataSize = arraySize * sizeof(stringIndexesWithLen[0]) + allStringsSize * sizeof(allStrings[0]);
+    if (ownData) {
+        npc(usage)->addHeap(name, dataSize);
+    }
+    else {
+        // The strings immediately follow the indexes in the file.
+        npc(usage)->addMapped(name, stringIndexesWithLen, dataSize);
+    }
+}
+
 void inflection::dictionary::metadata::StringArrayContainer::write(::std::ostream& output) const
 {
     output.write(reinterpret_cast<const char*>(&arraySize), sizeof(arraySize));
@@ -80,6 +93,11 @@ void inflection::dictionary::metadata::StringArrayContainer::write(::std::ostrea
 }
 
 ::std::u16string inflection::dictionary::metadata::StringArrayContainer::getString(int32_t offset) const
+{
+    return ::std::u16string(getStringView(offset));
+}
+
+::std::u16string_view inflection::dictionary::metadata::StringArrayContainer::getStringView(int32_t offset) const
 {
     if (offset < 0 || arraySize <= offset) {
         throw ::inflection::exception::IndexOutOfBoundsException(u"Offset is out of bounds");
@@ -87,7 +105,7 @@ void inflection::dictionary::metadata::StringArrayContainer::write(::std::ostrea
     int32_t value = stringIndexesWithLen[offset];
     int32_t len = value & LENGTH_MASK;
     int32_t stringStart = value >> LENGTH_BITS;
-    return std::u16string(allStrings + stringStart, len);
+    return std::u16string_view(allStrings + stringStart, len);
 }
 
 int32_t inflection::dictionary::metadata::StringArrayContainer::getIdentifierIfAvailable(::std::u16string_view string) const
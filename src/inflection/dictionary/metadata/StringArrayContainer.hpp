@@ -5,11 +5,13 @@
 
 #include <inflection/dictionary/metadata/fwd.hpp>
 #include <inflection/util/MemoryMappedFile.hpp>
+#include <inflection/util/fwd.hpp>
 
 #include <cstdint>
 #include <map>
 #include <set>
 #include <ostream>
+#include <string_view>
 
 /**
  * A simple array of strings. No compression is involved. This is smaller and faster for small quantities of strings.
@@ -26,6 +28,8 @@ public:
     void write(::std::ostream& output) const;
 
     ::std::u16string getString(int32_t identifier) const;
+    /** Like getString, but the view points into this container. */
+    ::std::u16string_view getStringView(int32_t identifier) const;
     /** Return -1 if not present */
     int32_t getIdentifierIfAvailable(::std::u16string_view string) const;
     /** Throw an exception if not present */
@@ -34,6 +38,8 @@ public:
     //Returns the number of strings in the container
     int32_t size() const;
 
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const;
+
     explicit StringArrayContainer(inflection::util::MemoryMappedFile *mappedFile);
     explicit StringArrayContainer(const ::std::set<::std::u16string_view>& strings, ::std::map<::std::u16string_view, int32_t>* mappingResult);
     StringArrayContainer();
@@ -6,6 +6,7 @@
 #include <inflection/dictionary/metadata/MarisaTrie.hpp>
 #include <inflection/exception/IllegalArgumentException.hpp>
 #include <inflection/util/MemoryMappedFile.hpp>
+#include <inflection/util/MemoryUsage.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/Validate.hpp>
 #include <marisa/iostream.h>
@@ -30,6 +31,8 @@ StringContainer::StringContainer(::inflection::util::MemoryMappedFile *mappedFil
         mappedFile->read(&rawTrieData, trieSize);
 
         trie.map(rawTrieData, trieSize);
+        mappedTrieData = rawTrieData;
+        mappedTrieSize = trieSize;
         _size = (int32_t) trie.num_keys();
     }
 }
@@ -65,7 +68,12 @@ static MarisaTrie<int8_t>::EncodingEnum getEncoding(const ::std::set<::std::u16s
 }
 
 StringContainer::StringContainer(const ::std::set<std::u16string_view>& data, ::std::map<std::u16string_view, int32_t>* mappingResult)
-    : encodingEnum(getEncoding(data))
+    : StringContainer(data, mappingResult, false)
+{
+}
+
+StringContainer::StringContainer(const ::std::set<std::u16string_view>& data, ::std::map<std::u16string_view, int32_t>* mappingResult, bool utf8Encoding)
+    : encodingEnum(utf8Encoding ? MarisaTrie<int8_t>::UTF8 : getEncoding(data))
     , encoder(MarisaTrie<int8_t>::getEncodingName((MarisaTrie<int8_t>::EncodingEnum)encodingEnum))
     , _size(int32_t(data.size()))
 {
@@ -123,11 +131,24 @@ void StringContainer::write(::std::ostream& output) const
 ::std::u16string StringContainer::getString(int32_t identifier) const
 {
     ::std::u16string result;
+    appendString(&result, identifier);
+    return result;
+}
+
+void StringContainer::appendString(::std::u16string* dest, int32_t identifier) const
+{
     ::marisa::Agent agent;
     agent.set_query(identifier);
     trie.reverse_lookup(agent);
-    encoder.decode(&result, agent.key().ptr(), int32_t(agent.key().length()));
-    return result;
+    encoder.decodeAppend(dest, agent.key().ptr(), int32_t(agent.key().length()));
+}
+
+void StringContainer::appendString(::std::string* dest, int32_t identifier) const
+{
+    ::marisa::Agent agent;
+    agent.set_query(identifier);
+    trie.reverse_lookup(agent);
+    encoder.decodeAppend(dest, agent.key().ptr(), int32_t(agent.key().length()));
 }
 
 int32_t StringContainer::getIdentifierIfAvailable(::std::u16string_view string) const
@@ -175,4 +196,14 @@ int32_t StringContainer::size() const {
     return _size;
 }
 
+void StringContainer::addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const
+{
+    if (mappedTrieData != nullptr) {
+        npc(usage)->addMapped(name, mappedTrieData, mappedTrieSize);
+    }
+    else {
+        npc(usage)->addHeap(name, trie.io_size());
+    }
+}
+
 } // namespace inflection::dictionary::metadata
@@ -6,6 +6,7 @@
 #include <inflection/dictionary/metadata/fwd.hpp>
 #include <inflection/dictionary/metadata/CharsetConverter.hpp>
 #include <inflection/util/MemoryMappedFile.hpp>
+#include <inflection/util/fwd.hpp>
 #include <marisa/trie.h>
 
 #include <map>
@@ -21,11 +22,17 @@ private:
     marisa::Trie trie {  };
     ::inflection::dictionary::metadata::CharsetConverter encoder;
     int32_t _size = 0;
+    const char* mappedTrieData {  };
+    int32_t mappedTrieSize {  };
 
 public:
     void write(::std::ostream& output) const;
 
     ::std::u16string getString(int32_t identifier) const;
+    /** Appends the string to dest instead of creating a new string. */
+    void appendString(::std::u16string* dest, int32_t identifier) const;
+    /** Appends the string to dest as UTF-8. */
+    void appendString(::std::string* dest, int32_t identifier) const;
     /** Return -1 if not present */
     int32_t getIdentifierIfAvailable(::std::u16string_view string) const;
     /** Throw an exception if not present */
@@ -37,8 +44,12 @@ public:
     //Returns the number of strings in the container
     int32_t size() const;
 
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const;
+
     explicit StringContainer(inflection::util::MemoryMappedFile *mappedFile);
     explicit StringContainer(const ::std::set<::std::u16string_view>& strings, ::std::map<::std::u16string_view, int32_t>* mappingResult);
+    /** When utf8Encoding is true, the strings are stored as UTF-8 even when another encoding is more compact. */
+    StringContainer(const ::std::set<::std::u16string_view>& strings, ::std::map<::std::u16string_view, int32_t>* mappingResult, bool utf8Encoding);
     StringContainer();
     ~StringContainer();
 private:
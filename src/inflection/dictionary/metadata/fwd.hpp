@@ -22,6 +22,8 @@ namespace inflection
             class CompressedArray;
             template <typename T>
             class MarisaTrieIterator;
+            class KeyWeights;
+            class MembershipFilter;
             class StringArrayContainer;
             class StringContainer;
             /// @endcond
@@ -276,7 +276,7 @@ std::optional<::std::pair<::std::u16string, ::std::u16string>> DeGrammarSynthesi
     filterGrammemesFromSetThatDontContainGrammeme(propertiesDependentWord, dictionaryDeterminer);
     filterGrammemesFromSetThatDontContainGrammeme(propertiesHeadWord, dictionaryNoun);
 
-    if (::inflection::util::LoggerConfig::isTraceEnabled()) {
+    if (INFLECTION_IS_TRACE_ENABLED()) {
         ::inflection::util::Logger::trace(::std::u16string(u"\nPossible Grammemes for ") + determiner);
         for (auto grammeme : propertiesDependentWord) {
             ::inflection::util::Logger::trace(inflection::util::StringViewUtils::join(dictionary.getPropertyNames(grammeme), u",") + u"\n");
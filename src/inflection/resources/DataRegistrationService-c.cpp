@@ -42,3 +42,43 @@ idr_getDataPathForLocale(const char* locale, char* dest, int32_t destCapacity, U
     }
     return -1;
 }
+
+INFLECTION_CAPI void
+idr_registerDictionaryForLocale(const char* locale, const char* path, UErrorCode* status)
+{
+    if (status != nullptr && U_SUCCESS(*status)) {
+        try {
+            DataRegistrationService::registerDictionaryForLocale(inflection::util::ULocale(npc(locale)), npc(path));
+        }
+        catch (const ::std::exception& e) {
+            inflection::util::TypeConversionUtils::convert(e, status);
+        }
+    }
+}
+
+INFLECTION_CAPI void
+idr_registerBundle(const char* bundlePath, const char* mountPath, UErrorCode* status)
+{
+    if (status != nullptr && U_SUCCESS(*status)) {
+        try {
+            DataRegistrationService::registerBundle(npc(bundlePath), npc(mountPath));
+        }
+        catch (const ::std::exception& e) {
+            inflection::util::TypeConversionUtils::convert(e, status);
+        }
+    }
+}
+
+INFLECTION_CAPI bool
+idr_unregisterBundle(const char* bundlePath, UErrorCode* status)
+{
+    if (status != nullptr && U_SUCCESS(*status)) {
+        try {
+            return DataRegistrationService::unregisterBundle(npc(bundlePath));
+        }
+        catch (const ::std::exception& e) {
+            inflection::util::TypeConversionUtils::convert(e, status);
+        }
+    }
+    return false;
+}
@@ -4,7 +4,9 @@
 //
 #include <inflection/resources/DataRegistrationService.hpp>
 
+#include <inflection/dictionary/DictionaryMetaData.hpp>
 #include <inflection/util/ArrayUtils.hpp>
+#include <inflection/util/ResourceBundle.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/ULocale.hpp>
 #include <inflection/util/Validate.hpp>
@@ -72,9 +74,8 @@ static std::string_view fallthroughLocaleString(const inflection::util::ULocale&
     return locale.getLanguage();
 }
 
-void DataRegistrationService::registerDataPathForLocale(const inflection::util::ULocale& locale, const std::string& path)
+static std::string normalizePath(const std::string& path)
 {
-    auto language(fallthroughLocaleString(locale));
     auto normalizedPath(path);
     std::string_view fileURLPrefix("file://");
     if (normalizedPath.compare(0, fileURLPrefix.size(), fileURLPrefix) == 0) {
@@ -83,7 +84,13 @@ void DataRegistrationService::registerDataPathForLocale(const inflection::util::
     while (!normalizedPath.empty() && normalizedPath.back() == '/') {
         normalizedPath.pop_back();
     }
-    normalizedPath = std::filesystem::weakly_canonical(std::filesystem::path(normalizedPath)).make_preferred().string();
+    return std::filesystem::weakly_canonical(std::filesystem::path(normalizedPath)).make_preferred().string();
+}
+
+void DataRegistrationService::registerDataPathForLocale(const inflection::util::ULocale& locale, const std::string& path)
+{
+    auto language(fallthroughLocaleString(locale));
+    auto normalizedPath(normalizePath(path));
 
     std::lock_guard<std::mutex> guard(CLASS_MUTEX());
     auto& pathsMap = *npc(PATHS_MAP());
@@ -105,4 +112,21 @@ std::string DataRegistrationService::getDataPathForLocale(const inflection::util
     return ::std::string();
 }
 
+void DataRegistrationService::registerDictionaryForLocale(const inflection::util::ULocale& locale, const std::string& path)
+{
+    // The dictionary does its own locking, and lookups don't wait for this.
+    ::inflection::dictionary::DictionaryMetaData::replaceDictionary(locale, inflection::util::StringViewUtils::to_u16string(normalizePath(path)));
+}
+
+void DataRegistrationService::registerBundle(const std::string& bundlePath, const std::string& mountPath)
+{
+    ::inflection::util::ResourceBundle::registerBundle(inflection::util::StringViewUtils::to_u16string(normalizePath(bundlePath)),
+                                                       inflection::util::StringViewUtils::to_u16string(normalizePath(mountPath)));
+}
+
+bool DataRegistrationService::unregisterBundle(const std::string& bundlePath)
+{
+    return ::inflection::util::ResourceBundle::unregisterBundle(inflection::util::StringViewUtils::to_u16string(normalizePath(bundlePath)));
+}
+
 } // namespace inflection::resources
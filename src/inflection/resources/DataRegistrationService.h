@@ -24,3 +24,36 @@ INFLECTION_CAPI void idr_registerDataPathForLocale(const char* locale, const cha
  *         only some of the result was written to the destination buffer.
  */
 INFLECTION_CAPI int32_t idr_getDataPathForLocale(const char* locale, char* dest, int32_t destCapacity, UErrorCode* status);
+/**
+ * Replaces the lexical dictionary for the language of a given locale with the dictionary file at the given path.
+ * Lookups are not blocked while the dictionary is replaced.
+ *
+ * @param locale The locale to replace the dictionary for.
+ * @param path The path of the dictionary file on the filesystem (relative or absolute).
+ * @param status Must be a valid pointer to an error code value,
+ *        which must not indicate a failure before the function call.
+ *        This is set to a failure when a failure has occurred during execution.
+ */
+INFLECTION_CAPI void idr_registerDictionaryForLocale(const char* locale, const char* path, UErrorCode* status);
+/**
+ * Registers a resource bundle, which is a single file that contains the data files of any number of locales.
+ * The paths in the bundle are relative to the mount path.
+ *
+ * @param bundlePath The path of the bundle file on the filesystem (relative or absolute).
+ * @param mountPath The directory that the paths in the bundle are relative to.
+ * @param status Must be a valid pointer to an error code value,
+ *        which must not indicate a failure before the function call.
+ *        This is set to a failure when a failure has occurred during execution.
+ */
+INFLECTION_CAPI void idr_registerBundle(const char* bundlePath, const char* mountPath, UErrorCode* status);
+/**
+ * Stops using a resource bundle that was registered with idr_registerBundle.
+ * Data that is already loaded from it is not changed.
+ *
+ * @param bundlePath The path of the bundle file that was given to idr_registerBundle.
+ * @param status Must be a valid pointer to an error code value,
+ *        which must not indicate a failure before the function call.
+ *        This is set to a failure when a failure has occurred during execution.
+ * @return true when a bundle with that path was registered.
+ */
+INFLECTION_CAPI bool idr_unregisterBundle(const char* bundlePath, UErrorCode* status);
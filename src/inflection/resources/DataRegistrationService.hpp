@@ -46,4 +46,42 @@ public:
      * @return The path exactly as previously registered.
      */
     static std::string getDataPathForLocale(const inflection::util::ULocale& locale);
+    /**
+     * Replace the lexical dictionary of the language of a locale with the dictionary file at the given path.
+     * Unlike registerDataPathForLocale, this can be called at any time, and lookups are not blocked while the
+     * dictionary is replaced. Lookups in progress finish with the previous dictionary, and later lookups use the new one.
+     * This call returns after the previous dictionary is no longer in use, and then it is unmapped.
+     * An iterator of the known words of the previous dictionary keeps using it, and then the previous dictionary is
+     * unmapped after the last such iterator is deleted.
+     *
+     * The same caveats as registerDataPathForLocale apply. The new dictionary must be built for this version of Inflection.
+     *
+     * @param locale The locale to replace the dictionary for.
+     * @param path The path of the dictionary file on the filesystem (relative or absolute).
+     * @throws IOException Thrown when the file can not be read. The current dictionary continues to be used.
+     * @throws IllegalArgumentException Thrown when the dictionary is for a different language.
+     */
+    static void registerDictionaryForLocale(const inflection::util::ULocale& locale, const std::string& path);
+    /**
+     * Register a resource bundle, which is a single file that contains the data files of any number of locales.
+     * The bundle is created with the buildResourceBundle tool. The paths in the bundle are relative to the mount path,
+     * and afterwards the data in the bundle is used instead of the files at those paths.
+     * Typically the mount path is the directory that was given to the tool as the root, or a path that is registered
+     * with registerDataPathForLocale. The files at the mount path do not need to exist.
+     * A bundle registered later takes precedence over a bundle registered earlier when both contain the same path.
+     * Register the bundle before the data of those locales is used. Data that is already loaded is not changed.
+     *
+     * @param bundlePath The path of the bundle file on the filesystem (relative or absolute).
+     * @param mountPath The directory that the paths in the bundle are relative to.
+     * @throws IOException Thrown when the bundle can not be read.
+     */
+    static void registerBundle(const std::string& bundlePath, const std::string& mountPath);
+    /**
+     * Stop using a resource bundle that was registered with registerBundle. Data that is already loaded from it is not
+     * changed, and the bundle stays mapped while that data may use it.
+     *
+     * @param bundlePath The path of the bundle file that was given to registerBundle.
+     * @return true when a bundle with that path was registered.
+     */
+    static bool unregisterBundle(const std::string& bundlePath);
 };
@@ -0,0 +1,152 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include <inflection/resources/MemoryBudget.hpp>
+
+#include <inflection/dialog/PronounConcept.hpp>
+#include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/exception/IllegalArgumentException.hpp>
+#include <inflection/tokenizer/TokenizerFactory.hpp>
+#include <inflection/npc.hpp>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace inflection::resources {
+
+static std::mutex& CLASS_MUTEX() {
+    static auto classMutex = new std::mutex();
+    return *npc(classMutex);
+}
+
+static ::std::atomic<int64_t>& MEMORY_BUDGET() {
+    static auto memoryBudget = new ::std::atomic<int64_t>(0);
+    return *npc(memoryBudget);
+}
+
+static ::std::atomic<int64_t>& EVICTION_COUNT() {
+    static auto evictionCount = new ::std::atomic<int64_t>(0);
+    return *npc(evictionCount);
+}
+
+static ::std::atomic<int64_t>& RELOAD_COUNT() {
+    static auto reloadCount = new ::std::atomic<int64_t>(0);
+    return *npc(reloadCount);
+}
+
+void MemoryBudget::evictLeastRecentlyUsed(::std::string_view loadedLanguage)
+{
+    auto memoryBudget = MEMORY_BUDGET().load();
+    if (memoryBudget == 0) {
+        return;
+    }
+    ::std::vector<::inflection::dictionary::DictionaryMetaData::LoadedDictionary> loadedDictionaries;
+    ::inflection::dictionary::DictionaryMetaData::getLoadedDictionaries(&loadedDictionaries);
+    int64_t totalBytes = 0;
+    for (auto& loadedDictionary : loadedDictionaries) {
+        loadedDictionary.bytes += ::inflection::tokenizer::TokenizerFactory::getCachedMemory(loadedDictionary.language);
+        loadedDictionary.bytes += ::inflection::dialog::PronounConcept::getCachedMemory(loadedDictionary.language);
+        totalBytes += loadedDictionary.bytes;
+    }
+    if (totalBytes <= memoryBudget) {
+        return;
+    }
+    ::std::stable_sort(loadedDictionaries.begin(), loadedDictionaries.end(), [](const auto& first, const auto& second) {
+        return first.lastUsed < second.lastUsed;
+    });
+    for (const auto& loadedDictionary : loadedDictionaries) {
+        if (totalBytes <= memoryBudget) {
+            break;
+        }
+        if (loadedDictionary.language == loadedLanguage) {
+            continue;
+        }
+        // Memory that is still referenced elsewhere is released later, so it still counts against the budget.
+        int64_t releasedBytes = ::inflection::dictionary::DictionaryMetaData::evictDictionary(loadedDictionary.language);
+        releasedBytes += ::inflection::tokenizer::TokenizerFactory::evictTokenizers(loadedDictionary.language);
+        releasedBytes += ::inflection::dialog::PronounConcept::evictPronounData(loadedDictionary.language);
+        if (releasedBytes > 0) {
+            EVICTION_COUNT().fetch_add(1);
+            totalBytes -= releasedBytes;
+        }
+    }
+}
+
+void MemoryBudget::setMemoryBudget(int64_t bytes)
+{
+    if (bytes < 0) {
+        throw ::inflection::exception::IllegalArgumentException(u"The memory budget can not be negative");
+    }
+    MEMORY_BUDGET().store(bytes);
+    enforceMemoryBudget();
+}
+
+int64_t MemoryBudget::getMemoryBudget()
+{
+    return MEMORY_BUDGET().load();
+}
+
+void MemoryBudget::enforceMemoryBudget()
+{
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    evictLeastRecentlyUsed({});
+}
+
+int64_t MemoryBudget::getEvictionCount()
+{
+    return EVICTION_COUNT().load();
+}
+
+int64_t MemoryBudget::getReloadCount()
+{
+    return RELOAD_COUNT().load();
+}
+
+static thread_local int32_t LOAD_SCOPE_DEPTH = 0;
+static thread_local ::std::optional<::std::string> PENDING_LANGUAGE;
+
+void MemoryBudget::enforceAfterLoading(::std::string_view language)
+{
+    // Another thread may be waiting for a lock that this thread holds, so don't wait for it.
+    // That thread is already enforcing the budget anyway.
+    std::unique_lock<std::mutex> guard(CLASS_MUTEX(), std::try_to_lock);
+    if (guard.owns_lock()) {
+        evictLeastRecentlyUsed(language);
+    }
+}
+
+void MemoryBudget::resourceLoaded(::std::string_view language, bool reloaded)
+{
+    if (reloaded) {
+        RELOAD_COUNT().fetch_add(1);
+    }
+    if (MEMORY_BUDGET().load() == 0) {
+        return;
+    }
+    if (LOAD_SCOPE_DEPTH > 0) {
+        if (!PENDING_LANGUAGE) {
+            PENDING_LANGUAGE.emplace(language);
+        }
+        return;
+    }
+    enforceAfterLoading(language);
+}
+
+MemoryBudget::LoadScope::LoadScope()
+{
+    LOAD_SCOPE_DEPTH++;
+}
+
+MemoryBudget::LoadScope::~LoadScope()
+{
+    if (--LOAD_SCOPE_DEPTH == 0 && PENDING_LANGUAGE) {
+        auto pendingLanguage(::std::move(*PENDING_LANGUAGE));
+        PENDING_LANGUAGE.reset();
+        enforceAfterLoading(pendingLanguage);
+    }
+}
+
+} // namespace inflection::resources
@@ -0,0 +1,85 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/dialog/fwd.hpp>
+#include <inflection/dictionary/fwd.hpp>
+#include <inflection/resources/fwd.hpp>
+#include <inflection/tokenizer/fwd.hpp>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Limits the memory used by the dictionaries and caches of the languages that are loaded.
+ * @details By default, the dictionaries, tokenizers and pronoun data of each language stay loaded for the lifetime of the process.
+ * When a memory budget is set, the resources of the least recently used languages are evicted whenever a language is loaded
+ * and the memory of the loaded languages is over the budget. An evicted resource is loaded again when it is next used.
+ * <p>
+ * The memory of a language is the resident memory of its dictionary and its cached tokenizer, and their heap memory,
+ * and the estimated heap memory of its pronoun data.
+ * A dictionary is unmapped when it is evicted. When an iterator of its known words or an inflection pattern still
+ * references it, it is unmapped by a later eviction after the last reference is deleted instead.
+ * Tokenizers and pronoun concepts that were already created keep their resources until they are deleted.
+ * Memory that is still referenced stays counted against the budget, and only the evictions that release memory are
+ * counted by getEvictionCount.
+ */
+class INFLECTION_CLASS_API inflection::resources::MemoryBudget final
+{
+public:
+    /**
+     * Set the memory budget, and evict the least recently used languages until the loaded languages fit within it.
+     * @param bytes The budget in bytes. 0 means unlimited, which is the default.
+     * @throws IllegalArgumentException Thrown when the budget is negative.
+     */
+    static void setMemoryBudget(int64_t bytes);
+    /**
+     * Returns the memory budget in bytes, or 0 when it is unlimited.
+     */
+    static int64_t getMemoryBudget();
+    /**
+     * Evict the least recently used languages until the loaded languages fit within the budget.
+     * This is done automatically when a language is loaded.
+     */
+    static void enforceMemoryBudget();
+    /**
+     * Returns the number of times that evicting the resources of a language released memory.
+     */
+    static int64_t getEvictionCount();
+    /**
+     * Returns the number of times that an evicted resource was loaded again.
+     */
+    static int64_t getReloadCount();
+
+private:
+    /**
+     * Called after a resource of a language is loaded. This does not wait when another thread is already enforcing the budget.
+     */
+    static void resourceLoaded(::std::string_view language, bool reloaded);
+    static void enforceAfterLoading(::std::string_view language);
+    /**
+     * Must be called while holding the class mutex.
+     * @param loadedLanguage The language that was just loaded, which is not evicted.
+     */
+    static void evictLeastRecentlyUsed(::std::string_view loadedLanguage);
+
+    /**
+     * Held while holding a lock of a cache that is evicted, and during each dictionary lookup. The budget is enforced
+     * after the last one on the thread is destroyed instead of while the lock is held or while the thread is reading
+     * a dictionary that an eviction would wait for.
+     */
+    class LoadScope final {
+    public:
+        LoadScope();
+        ~LoadScope();
+    private:
+        LoadScope(const LoadScope&) = delete;
+        LoadScope& operator=(const LoadScope&) = delete;
+    };
+
+    MemoryBudget() = delete;
+
+    friend class ::inflection::dialog::PronounConcept;
+    friend class ::inflection::dictionary::DictionaryMetaData;
+    friend class ::inflection::tokenizer::TokenizerFactory;
+};
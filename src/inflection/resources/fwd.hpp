@@ -13,5 +13,6 @@ namespace inflection
     {
         class DataRegistrationService;
         class DataResource;
+        class MemoryBudget;
     } // resources
 } // inflection
@@ -13,9 +13,11 @@
 #include <inflection/util/DelimitedStringIterator.hpp>
 #include <inflection/util/Logger.hpp>
 #include <inflection/util/LoggerConfig.hpp>
+#include <inflection/util/MemoryUsage.hpp>
 #include <inflection/util/ResourceLocator.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/ULocale.hpp>
+#include <inflection/npc.hpp>
 #include <icu4cxx/RegularExpression.hpp>
 #include <algorithm>
 #include <memory>
@@ -92,6 +94,11 @@ void TokenExtractor::readWordsToNotSplit(const ::std::map<::std::u16string_view,
     }
 }
 
+void TokenExtractor::addMemoryUsage(::inflection::util::MemoryUsage* usage) const
+{
+    npc(usage)->addHeap(locale.getName() + " words to not split", wordsToNotSplit.capacity() * sizeof(wordsToNotSplit[0]));
+}
+
 bool TokenExtractor::isWordToNotSplit(std::u16string_view str) const {
     if (minLenWordsToSplit == 0) {
         return false;
@@ -41,6 +41,10 @@ public: /* protected */
 public:
     const ::inflection::util::ULocale& getLocale() const;
     bool isContainRegex() const;
+    /**
+     * Add the memory of the data used by this token extractor, like a decompounding dictionary.
+     */
+    virtual void addMemoryUsage(::inflection::util::MemoryUsage* usage) const;
 
     TokenExtractor(const ::inflection::util::ULocale& locale, const ::std::map<::std::u16string_view, const char16_t*>& config);
     TokenExtractor(const ::inflection::util::ULocale& locale, const ::std::map<::std::u16string_view, const char16_t*>& config, bool (*isIndivisibleWordNormalized)(std::u16string_view str));
@@ -24,7 +24,7 @@ namespace inflection::tokenizer {
 Tokenizer::~Tokenizer() {
 }
 
-Tokenizer::Tokenizer(const tokenizer::TokenExtractor* wordExtractor)
+Tokenizer::Tokenizer(const ::std::shared_ptr<const tokenizer::TokenExtractor>& wordExtractor)
     : super()
     , tokenExtractor(wordExtractor)
 {
@@ -35,7 +35,7 @@ static constexpr char16_t DASH[] = { u"-" };
 
 TokenChain* Tokenizer::createTokenChain(std::u16string_view charSequence) const
 {
-    auto& extractor = *npc(this->tokenExtractor);
+    auto& extractor = *npc(this->tokenExtractor.get());
     int32_t end = int32_t(charSequence.length());
     auto headToken = new Token_Head();
     auto tailToken = new Token_Tail(int32_t(charSequence.length()));
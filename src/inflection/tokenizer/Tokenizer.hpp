@@ -8,6 +8,7 @@
 #include <inflection/Object.hpp>
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <string_view>
@@ -71,7 +72,7 @@ private:
     TokenizationType tokenizationType { TokenizationType::DEFAULT };
 
 private: /* package */
-    const ::inflection::tokenizer::TokenExtractor* tokenExtractor {  };
+    ::std::shared_ptr<const ::inflection::tokenizer::TokenExtractor> tokenExtractor {  };
 
 public:
     /**
@@ -91,7 +92,7 @@ public:
     virtual void setStyle(TokenizationType type);
 
 protected: /* protected */
-    explicit Tokenizer(const ::inflection::tokenizer::TokenExtractor* wordExtractor);
+    explicit Tokenizer(const ::std::shared_ptr<const ::inflection::tokenizer::TokenExtractor>& wordExtractor);
 public:
     Tokenizer(const Tokenizer&) = delete;
     Tokenizer& operator=(const Tokenizer&) = delete;
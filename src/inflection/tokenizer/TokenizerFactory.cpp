@@ -7,15 +7,19 @@
 #include <inflection/exception/InvalidConfigurationException.hpp>
 #include <inflection/exception/MissingResourceException.hpp>
 #include <inflection/resources/DataResource.hpp>
+#include <inflection/resources/MemoryBudget.hpp>
+#include <inflection/tokenizer/TokenExtractor.hpp>
 #include <inflection/util/ArrayUtils.hpp>
 #include <inflection/util/LocaleConstants.hpp>
 #include <inflection/util/Logger.hpp>
 #include <inflection/util/LoggerConfig.hpp>
+#include <inflection/util/MemoryUsage.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/ULocale.hpp>
 #include <inflection/tokenizer/TokenChain.hpp>
 #include <inflection/npc.hpp>
 #include <mutex>
+#include <set>
 
 #include <inflection/tokenizer/locale/DefaultTokenizer.hpp>
 #include <inflection/tokenizer/locale/ar/ArTokenizer.hpp>
@@ -50,14 +54,26 @@ bool readConfig(const ::std::u16string& locale, ::std::map<::std::u16string_view
     return !npc(config)->empty();
 }
 
+/**
+ * The languages whose tokenizers were evicted, and have not been created again.
+ */
+static ::std::set<::std::string, std::less<>>* EVICTED_LANGUAGES()
+{
+    static auto EVICTED_LANGUAGES_ = new ::std::set<::std::string, std::less<>>();
+    return EVICTED_LANGUAGES_;
+}
+
 Tokenizer* TokenizerFactory::createTokenizer(const util::ULocale& locale)
 {
+    // The cached tokenizer may be evicted after the lock is released, so its token extractor is shared instead.
+    ::std::shared_ptr<const TokenExtractor> tokenExtractor;
     const Tokenizer* tokenizer = nullptr;
     auto tokenizerCache = TOKENIZER_CACHE();
     {
         std::lock_guard<std::mutex> guard(CLASS_MUTEX());
         auto tokenizerEntry = npc(tokenizerCache)->find(locale.getName());
         if (tokenizerEntry != npc(tokenizerCache)->end()) {
+            tokenExtractor = npc(tokenizerEntry->second)->tokenExtractor;
             tokenizer = tokenizerEntry->second;
         }
     }
@@ -83,7 +99,11 @@ Tokenizer* TokenizerFactory::createTokenizer(const util::ULocale& locale)
                 throw exception::MissingResourceException(u"The tokenizer configuration files are missing.", u"TokenizerFactory", CONFIG_RESOURCE_PREFIX);
             }
         }
+        bool created = false;
+        bool reloaded = false;
         {
+            // Declared first, so that the budget is enforced after the lock is released.
+            ::inflection::resources::MemoryBudget::LoadScope loadScope;
             std::lock_guard<std::mutex> guard(CLASS_MUTEX());
             auto tokenizerEntry = npc(tokenizerCache)->find(fallbackLocale.getName());
             if (tokenizerEntry != npc(tokenizerCache)->end()) {
@@ -98,15 +118,85 @@ Tokenizer* TokenizerFactory::createTokenizer(const util::ULocale& locale)
                     tokenizer = createTokenizerObject(locale, config);
                     npc(tokenizerCache)->emplace(fallbackLocale.getName(), tokenizer);
                     npc(tokenizerCache)->emplace(locale.getName(), tokenizer);
+                    created = true;
+                    reloaded = npc(EVICTED_LANGUAGES())->erase(::std::string(locale.getLanguage())) > 0;
                 }
                 else {
                     // This should be impossible! The fallback should have been reused. We take the safe route just in case.
                     tokenizer = tokenizerEntry->second;
                 }
             }
+            tokenExtractor = npc(tokenizer)->tokenExtractor;
+        }
+        if (created) {
+            ::inflection::resources::MemoryBudget::resourceLoaded(locale.getLanguage(), reloaded);
+        }
+    }
+    return new Tokenizer(tokenExtractor);
+}
+
+void TokenizerFactory::getCacheMemoryUsage(::inflection::util::MemoryUsage* usage)
+{
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    auto tokenizerCache = TOKENIZER_CACHE();
+    size_t heapBytes = ::inflection::util::MemoryUsage::estimateNodeHeapBytes(*npc(tokenizerCache));
+    // Fallback locales share a tokenizer, so only report each one once.
+    ::std::set<const Tokenizer*> reportedTokenizers;
+    for (const auto& [localeName, tokenizer] : *tokenizerCache) {
+        heapBytes += localeName.capacity();
+        if (reportedTokenizers.insert(tokenizer).second) {
+            npc(npc(tokenizer)->tokenExtractor.get())->addMemoryUsage(usage);
+        }
+    }
+    npc(usage)->addHeap("tokenizer cache", heapBytes);
+}
+
+int64_t TokenizerFactory::getCachedMemory(::std::string_view language)
+{
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    ::std::set<const Tokenizer*> reportedTokenizers;
+    ::inflection::util::MemoryUsage usage;
+    for (const auto& [localeName, tokenizer] : *npc(TOKENIZER_CACHE())) {
+        if (util::ULocale(localeName).getLanguage() == language && reportedTokenizers.insert(tokenizer).second) {
+            npc(npc(tokenizer)->tokenExtractor.get())->addMemoryUsage(&usage);
         }
     }
-    return new Tokenizer(npc(tokenizer)->tokenExtractor);
+    return int64_t(usage.getResidentBytes() + usage.getHeapBytes());
+}
+
+int64_t TokenizerFactory::evictTokenizers(::std::string_view language)
+{
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    auto tokenizerCache = npc(TOKENIZER_CACHE());
+    ::std::set<const Tokenizer*> evictedTokenizers;
+    for (auto tokenizerEntry = tokenizerCache->begin(); tokenizerEntry != tokenizerCache->end();) {
+        if (util::ULocale(tokenizerEntry->first).getLanguage() == language) {
+            evictedTokenizers.insert(tokenizerEntry->second);
+            tokenizerEntry = tokenizerCache->erase(tokenizerEntry);
+        }
+        else {
+            ++tokenizerEntry;
+        }
+    }
+    for (const auto& [localeName, tokenizer] : *tokenizerCache) {
+        // Only the language of the locale changes in the fallback, but we take the safe route just in case.
+        evictedTokenizers.erase(tokenizer);
+    }
+    int64_t releasedBytes = 0;
+    for (auto tokenizer : evictedTokenizers) {
+        // Tokenizers that were already created share the token extractor, so it's deleted after they are.
+        // New references are only made while holding the lock, so an unshared token extractor is deleted here.
+        if (npc(tokenizer)->tokenExtractor.use_count() == 1) {
+            ::inflection::util::MemoryUsage usage;
+            npc(tokenizer->tokenExtractor.get())->addMemoryUsage(&usage);
+            releasedBytes += int64_t(usage.getResidentBytes() + usage.getHeapBytes());
+        }
+        delete tokenizer;
+    }
+    if (!evictedTokenizers.empty()) {
+        npc(EVICTED_LANGUAGES())->emplace(language);
+    }
+    return releasedBytes;
 }
 
 Tokenizer* TokenizerFactory::createTokenizerObject(const util::ULocale& locale, const ::std::map<::std::u16string_view, const char16_t*>& systemConfig)
@@ -134,7 +224,7 @@ Tokenizer* TokenizerFactory::createTokenizerObject(const util::ULocale& locale,
                 // We check for the logging status so that we don't construct a string that is never used.
                 util::Logger::infoComponent(COMPONENT_TOKENIZER, u"The tokenizer for " + locale.toString() + u" is being constructed for the first time.");
             }
-            auto tokenizer = new Tokenizer(entry->construct(locale, systemConfig));
+            auto tokenizer = new Tokenizer(::std::shared_ptr<const TokenExtractor>(entry->construct(locale, systemConfig)));
             // Initialize the data loading and caches so that it doesn't possibly fail later.
             delete npc(tokenizer)->createTokenChain(u"initialization");
             return tokenizer;
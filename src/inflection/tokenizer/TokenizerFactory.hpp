@@ -3,8 +3,10 @@
  */
 #pragma once
 
+#include <inflection/resources/fwd.hpp>
 #include <inflection/tokenizer/fwd.hpp>
 #include <inflection/util/fwd.hpp>
+#include <cstdint>
 #include <map>
 #include <string_view>
 
@@ -18,9 +20,25 @@ public:
      * Create the language specific tokenizer.
      */
     static Tokenizer* createTokenizer(const ::inflection::util::ULocale& locale);
+    /**
+     * Add the memory used by the cached tokenizers, and the estimated heap memory of the cache.
+     */
+    static void getCacheMemoryUsage(::inflection::util::MemoryUsage* usage);
 
 private:
+    /**
+     * Returns the resident and heap memory of the cached tokenizers of the language.
+     */
+    static int64_t getCachedMemory(::std::string_view language);
+    /**
+     * Remove the cached tokenizers of the language. They are created again when they are needed.
+     * The memory of a tokenizer is released after the tokenizers created from it are deleted.
+     * @return the resident and heap memory that was released.
+     */
+    static int64_t evictTokenizers(::std::string_view language);
     static Tokenizer* createTokenizerObject(const ::inflection::util::ULocale& locale, const ::std::map<::std::u16string_view, const char16_t*>& systemConfig);
 
     TokenizerFactory() = delete;
+
+    friend class ::inflection::resources::MemoryBudget;
 };
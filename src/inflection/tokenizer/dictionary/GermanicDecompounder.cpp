@@ -94,4 +94,9 @@ int32_t GermanicDecompounder::getMinimumCandidateLength() const
     return minCandidateLength;
 }
 
+void GermanicDecompounder::addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const
+{
+    corpus.addMemoryUsage(usage, name);
+}
+
 } // namespace inflection::tokenizer::dictionary
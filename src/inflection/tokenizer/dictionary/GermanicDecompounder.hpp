@@ -36,6 +36,7 @@ private:
 public:
     void decompound(std::vector<int32_t>* boundaries, std::u16string_view phrase, int32_t start, int32_t length) const;
     int32_t getMinimumCandidateLength() const;
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const;
 
 public:
     GermanicDecompounder(const DictionaryTokenizerConfig& config, const ::std::u16string& dictionaryPath);
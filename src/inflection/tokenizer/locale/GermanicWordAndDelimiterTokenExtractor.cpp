@@ -21,4 +21,10 @@ iterator::TokenExtractorIterator* GermanicWordAndDelimiterTokenExtractor::create
     return new GermanicTokenExtractorIterator(decompounder, str);
 }
 
+void GermanicWordAndDelimiterTokenExtractor::addMemoryUsage(::inflection::util::MemoryUsage* usage) const
+{
+    super::addMemoryUsage(usage);
+    decompounder.addMemoryUsage(usage, getLocale().getName() + " decompounder");
+}
+
 } // namespace inflection::tokenizer
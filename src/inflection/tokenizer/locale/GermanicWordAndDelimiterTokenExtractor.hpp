@@ -20,6 +20,7 @@ public: /* protected */
 
 public: /* protected */
     iterator::TokenExtractorIterator* createIterator(std::u16string_view str) const override;
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage) const override;
 
 public:
 
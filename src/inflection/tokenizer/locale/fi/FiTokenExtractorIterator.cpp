@@ -67,7 +67,7 @@ int32_t FiTokenExtractorIterator::getNextBoundary()
                         fiCompound.addBoundaries(MAXIMUM_DECOMPOUND_MORPHEMES, &boundaries);
                     }
                     catch (const ::inflection::exception::ExcessComplexityException &) {
-                        if (::inflection::util::LoggerConfig::isDebugEnabled()) {
+                        if (INFLECTION_IS_DEBUG_ENABLED()) {
                             ::inflection::util::Logger::debug(::std::u16string(u"The token \"") + sbWord
                                                            + ::std::u16string(u"\" is too complex to decompound"));
                         }
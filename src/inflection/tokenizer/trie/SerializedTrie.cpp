@@ -24,6 +24,11 @@ SerializedTrie::~SerializedTrie()
 {
 }
 
+void SerializedTrie::addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const
+{
+    trie.addMemoryUsage(usage, name);
+}
+
 ::inflection::util::MemoryMappedFile& SerializedTrie::validateHeader(::inflection::util::MemoryMappedFile& mappedFile, const std::u16string &corpusFile)
 {
     // Verify header starts with magic token
@@ -24,6 +24,11 @@ public:
     static constexpr char MAGIC_MARKER[8] { "MORPHTK" };
     static constexpr int32_t RESERVED_BYTES = 4; // Also used to align data structures after this header.
 
+    /**
+     * Add the mapped, resident and heap memory of the trie.
+     */
+    void addMemoryUsage(::inflection::util::MemoryUsage* usage, ::std::string_view name) const;
+
     explicit SerializedTrie(const std::u16string &corpusFile);
     ~SerializedTrie() override;
 };
@@ -3,6 +3,7 @@
  */
 #include <inflection/util/AutoFileDescriptor.hpp>
 
+#include <inflection/util/ResourceBundle.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <fcntl.h>
 #include <filesystem>
@@ -32,7 +33,8 @@ AutoFileDescriptor::~AutoFileDescriptor()
 
 bool AutoFileDescriptor::isAccessibleFile(std::u16string_view path)
 {
-    return std::filesystem::exists(path);
+    size_t sectionSize = 0;
+    return std::filesystem::exists(path) || ResourceBundle::findSection(path, &sectionSize) != nullptr;
 }
 
 } // namespace inflection::util
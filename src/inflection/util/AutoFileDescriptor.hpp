@@ -7,7 +7,7 @@
 #include <string>
 
 // Wrapper around a file descriptor that close()s on when dtor'd if valid
-class inflection::util::AutoFileDescriptor {
+class INFLECTION_INTERNAL_API inflection::util::AutoFileDescriptor {
 public:
     // Wraps open()
     AutoFileDescriptor(const char *path, int flags);
@@ -18,6 +18,7 @@ public:
         return fd;
     }
 
+    // True when the file exists, or when it is a section of a registered ResourceBundle.
     static bool isAccessibleFile(std::u16string_view path);
 
 private:
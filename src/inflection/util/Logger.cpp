@@ -166,13 +166,13 @@ static void logToTopOfStackLogger(ILogLevel logLevel, const char16_t* component,
 }
 
 void Logger::trace(std::u16string_view message) {
-    if (LoggerConfig::isTraceEnabled()) {
+    if (INFLECTION_IS_TRACE_ENABLED()) {
         logToTopOfStackLogger(ILOG_TRACE, nullptr, message);
     }
 }
 
 void Logger::debug(std::u16string_view message) {
-    if (LoggerConfig::isDebugEnabled()) {
+    if (INFLECTION_IS_DEBUG_ENABLED()) {
         logToTopOfStackLogger(ILOG_DEBUG, nullptr, message);
     }
 }
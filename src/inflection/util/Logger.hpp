@@ -8,6 +8,24 @@
 #include <string>
 #include <string_view>
 
+/**
+ * Trace and debug logging can be removed at compile time by defining INFLECTION_TRACE_LOGGING as 0, which is done
+ * with the CMake option TRACE_LOGGING=OFF. Then these checks are a constant false, and the compiler removes the code
+ * that builds the messages. Otherwise each check is one relaxed atomic load, so check once before a loop instead of
+ * in each iteration.
+ */
+#ifndef INFLECTION_TRACE_LOGGING
+#define INFLECTION_TRACE_LOGGING 1
+#endif
+
+#if INFLECTION_TRACE_LOGGING
+#define INFLECTION_IS_TRACE_ENABLED() (::inflection::util::LoggerConfig::isTraceEnabled())
+#define INFLECTION_IS_DEBUG_ENABLED() (::inflection::util::LoggerConfig::isDebugEnabled())
+#else
+#define INFLECTION_IS_TRACE_ENABLED() false
+#define INFLECTION_IS_DEBUG_ENABLED() false
+#endif
+
 class inflection::util::Logger final
 {
 public:
@@ -5,20 +5,22 @@
 #include <inflection/util/Logger.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/npc.hpp>
+#include <atomic>
 #include <iostream>
 
 namespace inflection::util {
 
-static ILogLevel gLogLevel = ILOG_INFO;
+// The level is read on hot paths from any thread, so the loads are relaxed.
+static ::std::atomic<ILogLevel> gLogLevel = ILOG_INFO;
 
 void
 LoggerConfig::setLogLevel(ILogLevel newLogLevel) {
-    gLogLevel = newLogLevel;
+    gLogLevel.store(newLogLevel, ::std::memory_order_relaxed);
 }
 
 ILogLevel
 LoggerConfig::getLogLevel() {
-    return gLogLevel;
+    return gLogLevel.load(::std::memory_order_relaxed);
 }
 
 INFLECTION_CBEGIN
@@ -54,27 +56,27 @@ LoggerConfig::logToConsole(bool value) {
 
 bool
 LoggerConfig::isTraceEnabled() {
-    return gLogLevel <= ILOG_TRACE;
+    return getLogLevel() <= ILOG_TRACE;
 }
 
 bool
 LoggerConfig::isDebugEnabled() {
-    return gLogLevel <= ILOG_DEBUG;
+    return getLogLevel() <= ILOG_DEBUG;
 }
 
 bool
 LoggerConfig::isInfoEnabled() {
-    return gLogLevel <= ILOG_INFO;
+    return getLogLevel() <= ILOG_INFO;
 }
 
 bool
 LoggerConfig::isWarnEnabled() {
-    return gLogLevel <= ILOG_WARNING;
+    return getLogLevel() <= ILOG_WARNING;
 }
 
 bool
 LoggerConfig::isErrorEnabled() {
-    return gLogLevel <= ILOG_ERROR;
+    return getLogLevel() <= ILOG_ERROR;
 }
 
 bool
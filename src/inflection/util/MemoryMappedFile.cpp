@@ -3,19 +3,70 @@
  */
 #include <inflection/util/MemoryMappedFile.hpp>
 
+#include <inflection/util/Logger.hpp>
+#include <inflection/util/LoggerConfig.hpp>
+#include <inflection/util/ResourceBundle.hpp>
+#include <algorithm>
+#include <atomic>
+#include <vector>
 #ifdef _WIN32
 #include <windows.h>
+#include <psapi.h>
 #else
 #include <inflection/util/AutoFileDescriptor.hpp>
 #include <sys/stat.h>
 #include <sys/mman.h>
+#include <cerrno>
 #include <fcntl.h>
+#include <unistd.h>
 #endif
 
 namespace inflection::util {
 
+static ::std::atomic<int32_t>& DEFAULT_RESIDENCY_POLICY()
+{
+    static auto DEFAULT_RESIDENCY_POLICY_ = new ::std::atomic<int32_t>(MemoryMappedFile::RESIDENCY_LAZY);
+    return *DEFAULT_RESIDENCY_POLICY_;
+}
+
+void MemoryMappedFile::setDefaultResidencyPolicy(int32_t residencyPolicy)
+{
+    DEFAULT_RESIDENCY_POLICY().store(residencyPolicy, ::std::memory_order_relaxed);
+}
+
+int32_t MemoryMappedFile::getDefaultResidencyPolicy()
+{
+    return DEFAULT_RESIDENCY_POLICY().load(::std::memory_order_relaxed);
+}
+
+static uintptr_t getPageSize()
+{
+#ifdef _WIN32
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+    return systemInfo.dwPageSize;
+#else
+    return uintptr_t(sysconf(_SC_PAGESIZE));
+#endif
+}
+
 MemoryMappedFile::MemoryMappedFile(const std::u16string& path)
+    : MemoryMappedFile(path, getDefaultResidencyPolicy())
 {
+}
+
+MemoryMappedFile::MemoryMappedFile(const std::u16string& path, int32_t residencyPolicy)
+{
+    size_t sectionSize = 0;
+    auto section = ResourceBundle::findSection(path, &sectionSize);
+    if (section != nullptr) {
+        // The bundle owns the mapping, and it applies to the whole bundle.
+        this->data = const_cast<char*>(section);
+        this->size = sectionSize;
+        this->owned = false;
+        this->bundleSection = true;
+        return;
+    }
 #ifdef _WIN32
     HANDLE hFile = CreateFileW(reinterpret_cast<const wchar_t*>(path.c_str()), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
     if (hFile == INVALID_HANDLE_VALUE) {
@@ -54,13 +105,20 @@ MemoryMappedFile::MemoryMappedFile(const std::u16string& path)
         throw ::inflection::exception::IOException(path + u" is not a regular file");
     }
     this->size = fileStat.st_size;
-    char* mappedFile = (char*) mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.getFD(), 0);
+    int mapFlags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+    if ((residencyPolicy & RESIDENCY_PREFAULT) != 0) {
+        mapFlags |= MAP_POPULATE;
+    }
+#endif
+    char* mappedFile = (char*) mmap(nullptr, size, PROT_READ, mapFlags, file.getFD(), 0);
     if (mappedFile == MAP_FAILED) {
         throw inflection::exception::IOException(u"Memory mapping failure of " + path);
     }
     this->data = mappedFile;
     this->owned = true;
 #endif
+    applyResidencyPolicy(residencyPolicy);
 }
 
 MemoryMappedFile::MemoryMappedFile(char* data, size_t size) :
@@ -68,8 +126,110 @@ MemoryMappedFile::MemoryMappedFile(char* data, size_t size) :
 {
 }
 
+void MemoryMappedFile::applyResidencyPolicy(int32_t residencyPolicy) const
+{
+    if (!owned || data == nullptr || size == 0 || residencyPolicy == RESIDENCY_LAZY) {
+        return;
+    }
+#ifdef _WIN32
+    if ((residencyPolicy & RESIDENCY_PREFAULT) != 0) {
+        WIN32_MEMORY_RANGE_ENTRY range { data, size };
+        PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+    }
+    if ((residencyPolicy & RESIDENCY_LOCKED) != 0 && !VirtualLock(data, size) && LoggerConfig::isWarnEnabled()) {
+        Logger::warn(u"Could not lock a memory mapped file in memory; error code " + StringUtils::to_u16string((int32_t)GetLastError()));
+    }
+#else
+    // The advice is only a hint. Failures are not fatal.
+    if ((residencyPolicy & RESIDENCY_RANDOM_ACCESS) != 0) {
+        madvise(data, size, MADV_RANDOM);
+    }
+#ifdef MADV_HUGEPAGE
+    if ((residencyPolicy & RESIDENCY_HUGE_PAGES) != 0) {
+        madvise(data, size, MADV_HUGEPAGE);
+    }
+#endif
+    if ((residencyPolicy & RESIDENCY_PREFAULT) != 0) {
+        madvise(data, size, MADV_WILLNEED);
+    }
+    if ((residencyPolicy & RESIDENCY_LOCKED) != 0 && mlock(data, size) != 0 && LoggerConfig::isWarnEnabled()) {
+        Logger::warn(u"Could not lock a memory mapped file in memory; errno " + StringUtils::to_u16string((int32_t)errno));
+    }
+#endif
+}
+
+void MemoryMappedFile::releaseResidentPages() const
+{
+    if ((!owned && !bundleSection) || data == nullptr || size == 0) {
+        return;
+    }
+    // A section of a bundle rarely starts on a page boundary. The pages at its edges are also released, and a
+    // neighbouring section that still uses them reads them from the file again.
+    const uintptr_t pageSize = getPageSize();
+    const auto rangeStart = reinterpret_cast<uintptr_t>(data);
+    const auto firstPage = rangeStart - (rangeStart % pageSize);
+    auto pagesStart = reinterpret_cast<char*>(firstPage);
+    const size_t pagesLength = rangeStart + size - firstPage;
+#ifdef _WIN32
+    // Unlocking pages that are not locked removes them from the working set.
+    VirtualUnlock(pagesStart, pagesLength);
+#else
+    // The mapping is read only, so the pages are reread from the file. Failures are not fatal.
+    madvise(pagesStart, pagesLength, MADV_DONTNEED);
+#endif
+}
+
+size_t MemoryMappedFile::getResidentSize(const void* start, size_t length)
+{
+    if (start == nullptr || length == 0) {
+        return 0;
+    }
+    const uintptr_t pageSize = getPageSize();
+    const auto rangeStart = reinterpret_cast<uintptr_t>(start);
+    const auto rangeEnd = rangeStart + length;
+    const auto firstPage = rangeStart - (rangeStart % pageSize);
+    const size_t numPages = (rangeEnd - firstPage + pageSize - 1) / pageSize;
+    ::std::vector<bool> isResident(numPages);
+#ifdef _WIN32
+    ::std::vector<PSAPI_WORKING_SET_EX_INFORMATION> pageInfo(numPages);
+    for (size_t idx = 0; idx < numPages; idx++) {
+        pageInfo[idx].VirtualAddress = reinterpret_cast<void*>(firstPage + idx * pageSize);
+    }
+    if (!QueryWorkingSetEx(GetCurrentProcess(), pageInfo.data(), DWORD(numPages * sizeof(pageInfo[0])))) {
+        return 0;
+    }
+    for (size_t idx = 0; idx < numPages; idx++) {
+        isResident[idx] = pageInfo[idx].VirtualAttributes.Valid != 0;
+    }
+#else
+#ifdef __APPLE__
+    ::std::vector<char> pageInfo(numPages);
+#else
+    ::std::vector<unsigned char> pageInfo(numPages);
+#endif
+    if (mincore(reinterpret_cast<void*>(firstPage), rangeEnd - firstPage, pageInfo.data()) != 0) {
+        return 0;
+    }
+    for (size_t idx = 0; idx < numPages; idx++) {
+        isResident[idx] = (pageInfo[idx] & 1) != 0;
+    }
+#endif
+    size_t result = 0;
+    for (size_t idx = 0; idx < numPages; idx++) {
+        if (isResident[idx]) {
+            const auto pageStart = firstPage + idx * pageSize;
+            result += ::std::min(pageStart + pageSize, rangeEnd) - ::std::max(pageStart, rangeStart);
+        }
+    }
+    return result;
+}
+
 MemoryMappedFile::~MemoryMappedFile()
 {
+    if (bundleSection) {
+        // The bundle stays mapped, so its pages would otherwise stay resident after this is deleted.
+        releaseResidentPages();
+    }
     if (owned && data) {
 #ifdef _WIN32
         UnmapViewOfFile(data);
@@ -11,10 +11,34 @@
 class INFLECTION_INTERNAL_API inflection::util::MemoryMappedFile final
 {
 public:
+    /**
+     * How the pages of a mapped file are brought into memory. The bits can be combined.
+     * The operating system treats these as hints, and unsupported hints are ignored.
+     */
+    enum ResidencyPolicy : int32_t {
+        /** Pages are read on the first access. This is the default. */
+        RESIDENCY_LAZY = 0,
+        /** Read all of the pages when the file is mapped, or as soon as possible when applied later. */
+        RESIDENCY_PREFAULT = 1,
+        /** Disable read ahead. Trie lookups jump around the file, so read ahead mostly reads unused pages. */
+        RESIDENCY_RANDOM_ACCESS = 2,
+        /** Lock the pages in memory so that they are never paged out. This is subject to the process memory lock limit. */
+        RESIDENCY_LOCKED = 4,
+        /** Request transparent huge pages when the kernel supports them for file mappings. */
+        RESIDENCY_HUGE_PAGES = 8,
+    };
+
+    /**
+     * Maps the file with the default residency policy.
+     */
     explicit MemoryMappedFile(const std::u16string& path);
+    MemoryMappedFile(const std::u16string& path, int32_t residencyPolicy);
 
     MemoryMappedFile(char* data, size_t size);
 
+    /**
+     * Unmap the file. A section of a resource bundle stays mapped by the bundle, so its resident pages are released instead.
+     */
     ~MemoryMappedFile();
 
     size_t getSize() const {
@@ -25,6 +49,29 @@ public:
         return data;
     }
 
+    /**
+     * Apply the ResidencyPolicy bits to an existing mapping. This does nothing when the memory is not owned by this object.
+     */
+    void applyResidencyPolicy(int32_t residencyPolicy) const;
+
+    /**
+     * Set the ResidencyPolicy bits used for files mapped after this call.
+     */
+    static void setDefaultResidencyPolicy(int32_t residencyPolicy);
+    static int32_t getDefaultResidencyPolicy();
+
+    /**
+     * Get the number of bytes in the given range that are currently in physical memory.
+     * The pages that partially overlap the range are counted as the overlapping part of the page.
+     */
+    static size_t getResidentSize(const void* start, size_t length);
+    /**
+     * Drop the pages of the mapping from physical memory. They are read from the file again when they are next accessed.
+     * For a section of a resource bundle, the pages that overlap the section are dropped.
+     * This does nothing when the memory is not a mapped file.
+     */
+    void releaseResidentPages() const;
+
 private:
     template <typename X>
     static void readFromCursor(char* readCursorWrapper, X* out)
@@ -86,5 +133,7 @@ private:
     void* mappingHandle = {  };
 #endif
     bool owned = {  };
+    /** The memory is a section of a file mapped by a ResourceBundle. */
+    bool bundleSection = {  };
 };
 
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include <inflection/util/MemoryUsage.hpp>
+
+#include <inflection/util/MemoryMappedFile.hpp>
+
+namespace inflection::util {
+
+void MemoryUsage::addMapped(::std::string_view name, const void* start, size_t length)
+{
+    sections.emplace_back(Section{::std::string(name), length, MemoryMappedFile::getResidentSize(start, length), 0});
+}
+
+void MemoryUsage::addHeap(::std::string_view name, size_t heapBytes)
+{
+    sections.emplace_back(Section{::std::string(name), 0, 0, heapBytes});
+}
+
+const ::std::vector<MemoryUsage::Section>& MemoryUsage::getSections() const
+{
+    return sections;
+}
+
+size_t MemoryUsage::getMappedBytes() const
+{
+    size_t result = 0;
+    for (const auto& section : sections) {
+        result += section.mappedBytes;
+    }
+    return result;
+}
+
+size_t MemoryUsage::getResidentBytes() const
+{
+    size_t result = 0;
+    for (const auto& section : sections) {
+        result += section.residentBytes;
+    }
+    return result;
+}
+
+size_t MemoryUsage::getHeapBytes() const
+{
+    size_t result = 0;
+    for (const auto& section : sections) {
+        result += section.heapBytes;
+    }
+    return result;
+}
+
+} // namespace inflection::util
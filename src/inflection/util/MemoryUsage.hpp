@@ -0,0 +1,75 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/api.h>
+
+#include <inflection/util/fwd.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Reports the memory used by Inflection's data structures.
+ * @details Memory mapped data is reported separately from heap memory. The mapped bytes of a section are the size of the
+ * section in its file, and the resident bytes are the mapped bytes currently in physical memory.
+ * The heap bytes are an estimate that does not include the overhead of the memory allocator.
+ */
+class INFLECTION_CLASS_API inflection::util::MemoryUsage final
+{
+public:
+    /**
+     * The memory used by a named data structure.
+     */
+    class Section final {
+    public:
+        /** The name of the data structure. */
+        ::std::string name {  };
+        /** The size of the memory mapped data. */
+        size_t mappedBytes {  };
+        /** The amount of mapped data that is currently in physical memory. */
+        size_t residentBytes {  };
+        /** The estimated heap memory owned by the data structure. */
+        size_t heapBytes {  };
+    };
+
+    /**
+     * Add a section of memory mapped data. The resident size is calculated when it is added.
+     */
+    void addMapped(::std::string_view name, const void* start, size_t length);
+    /**
+     * Add a section of heap memory.
+     */
+    void addHeap(::std::string_view name, size_t heapBytes);
+
+    /**
+     * All of the sections in the order that they were added.
+     */
+    const ::std::vector<Section>& getSections() const;
+    /**
+     * The sum of the mapped bytes of all sections.
+     */
+    size_t getMappedBytes() const;
+    /**
+     * The sum of the resident bytes of all sections.
+     */
+    size_t getResidentBytes() const;
+    /**
+     * The sum of the heap bytes of all sections.
+     */
+    size_t getHeapBytes() const;
+
+    /**
+     * Estimate the heap used by the nodes of a node based container, like std::map.
+     * This does not include the heap memory owned by the elements.
+     */
+    template <typename Container>
+    static size_t estimateNodeHeapBytes(const Container& container) {
+        // Each node has the element, 3 tree pointers and the node color.
+        return container.size() * (sizeof(typename Container::value_type) + 4 * sizeof(void*));
+    }
+
+private:
+    ::std::vector<Section> sections {  };
+};
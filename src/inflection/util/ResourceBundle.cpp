@@ -0,0 +1,210 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include <inflection/util/ResourceBundle.hpp>
+
+#include <inflection/exception/IncompatibleVersionException.hpp>
+#include <inflection/exception/IOException.hpp>
+#include <inflection/npc.hpp>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+namespace inflection::util {
+
+static std::mutex& CLASS_MUTEX() {
+    static auto classMutex = new std::mutex();
+    return *npc(classMutex);
+}
+
+typedef ::std::vector<const ResourceBundle*> RegisteredBundles;
+
+/**
+ * The registered bundles are a copy-on-write snapshot. A published snapshot is never modified, which lets every
+ * MemoryMappedFile and every file check search the bundles without taking CLASS_MUTEX.
+ */
+static ::std::atomic<const RegisteredBundles*>& REGISTERED_BUNDLES()
+{
+    static auto REGISTERED_BUNDLES_ = new ::std::atomic<const RegisteredBundles*>(new RegisteredBundles());
+    return *npc(REGISTERED_BUNDLES_);
+}
+
+::std::string ResourceBundle::normalizePath(::std::u16string_view path)
+{
+    auto normalized(::std::filesystem::weakly_canonical(::std::filesystem::path(path)).generic_u8string());
+    return ::std::string(reinterpret_cast<const char*>(normalized.data()), normalized.length());
+}
+
+ResourceBundle::ResourceBundle(const ::std::u16string& bundlePath, const ::std::u16string& mountPath)
+    : mappedFile(bundlePath, MemoryMappedFile::RESIDENCY_LAZY)
+    , bundlePath(normalizePath(bundlePath))
+    , mountPrefix(normalizePath(mountPath))
+{
+    if (mountPrefix.empty() || mountPrefix.back() != '/') {
+        mountPrefix.push_back('/');
+    }
+    const char* magicMarker;
+    mappedFile.read(&magicMarker, sizeof(MAGIC_MARKER));
+    if (strncmp(magicMarker, MAGIC_MARKER, sizeof(MAGIC_MARKER)) != 0) {
+        throw ::inflection::exception::IOException(u"Input file " + bundlePath + u" has an invalid header");
+    }
+    if (mappedFile.read<int64_t>() != VERSION) {
+        throw ::inflection::exception::IncompatibleVersionException(u"Input file " + bundlePath + u" has an incompatible version");
+    }
+    if (mappedFile.read<int16_t>() != ENDIANNESS_MARKER) {
+        throw ::inflection::exception::IOException(u"Input file " + bundlePath + u" was built for a different architecture");
+    }
+    mappedFile.read<int16_t>(); // OPTIONS: currently unused.
+    auto sectionCount = mappedFile.read<int32_t>();
+    if (sectionCount < 0) {
+        throw ::inflection::exception::IOException(u"Input file " + bundlePath + u" has an invalid table of contents");
+    }
+    auto entries = mappedFile.readArray<const Entry>(sectionCount);
+    auto namesLength = mappedFile.read<int32_t>();
+    auto names = mappedFile.readArray<const char>(namesLength < 0 ? 0 : namesLength);
+    const auto fileSize = int64_t(mappedFile.getSize());
+    for (int32_t idx = 0; idx < sectionCount; idx++) {
+        const auto& entry = entries[idx];
+        if (entry.nameOffset < 0 || entry.nameLength < 0 || int64_t(entry.nameOffset) + entry.nameLength > namesLength
+            || entry.offset < 0 || entry.length < 0 || entry.offset > fileSize || entry.length > fileSize - entry.offset)
+        {
+            throw ::inflection::exception::IOException(u"Input file " + bundlePath + u" has an invalid table of contents");
+        }
+        sections.emplace(::std::string_view(names + entry.nameOffset, entry.nameLength),
+                         ::std::string_view(mappedFile.getData() + entry.offset, size_t(entry.length)));
+    }
+}
+
+static void writePadding(::std::ostream& out, int64_t* offset)
+{
+    static constexpr char PADDING[ResourceBundle::SECTION_ALIGNMENT] = {  };
+    auto paddingLength = (ResourceBundle::SECTION_ALIGNMENT - (*offset % ResourceBundle::SECTION_ALIGNMENT)) % ResourceBundle::SECTION_ALIGNMENT;
+    out.write(PADDING, paddingLength);
+    *offset += paddingLength;
+}
+
+void ResourceBundle::write(::std::ostream& out, const ::std::map<::std::string, ::std::u16string>& sections)
+{
+    ::std::vector<::std::unique_ptr<MemoryMappedFile>> files;
+    ::std::vector<Entry> entries;
+    ::std::string names;
+    auto sectionCount = int32_t(sections.size());
+    int64_t offset = sizeof(MAGIC_MARKER) + sizeof(VERSION) + sizeof(ENDIANNESS_MARKER) + sizeof(OPTIONS) + sizeof(sectionCount)
+        + sectionCount * int64_t(sizeof(Entry)) + sizeof(int32_t);
+    for (const auto& [name, path] : sections) {
+        names.append(name);
+    }
+    offset += int64_t(names.length());
+    offset += (SECTION_ALIGNMENT - (offset % SECTION_ALIGNMENT)) % SECTION_ALIGNMENT;
+    int32_t nameOffset = 0;
+    for (const auto& [name, path] : sections) {
+        files.emplace_back(new MemoryMappedFile(path, MemoryMappedFile::RESIDENCY_LAZY));
+        auto length = int64_t(files.back()->getSize());
+        entries.emplace_back(Entry{offset, length, nameOffset, int32_t(name.length())});
+        nameOffset += int32_t(name.length());
+        offset += length;
+        offset += (SECTION_ALIGNMENT - (offset % SECTION_ALIGNMENT)) % SECTION_ALIGNMENT;
+    }
+
+    out.write(MAGIC_MARKER, sizeof(MAGIC_MARKER));
+    out.write(reinterpret_cast<const char*>(&VERSION), sizeof(VERSION));
+    out.write(reinterpret_cast<const char*>(&ENDIANNESS_MARKER), sizeof(ENDIANNESS_MARKER));
+    out.write(reinterpret_cast<const char*>(&OPTIONS), sizeof(OPTIONS));
+    out.write(reinterpret_cast<const char*>(&sectionCount), sizeof(sectionCount));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+    auto namesLength = int32_t(names.length());
+    out.write(reinterpret_cast<const char*>(&namesLength), sizeof(namesLength));
+    out.write(names.data(), names.length());
+    int64_t written = sizeof(MAGIC_MARKER) + sizeof(VERSION) + sizeof(ENDIANNESS_MARKER) + sizeof(OPTIONS) + sizeof(sectionCount)
+        + int64_t(entries.size() * sizeof(Entry)) + sizeof(namesLength) + namesLength;
+    writePadding(out, &written);
+    for (const auto& file : files) {
+        out.write(file->getData(), file->getSize());
+        written += int64_t(file->getSize());
+        writePadding(out, &written);
+    }
+    if (!out) {
+        throw ::inflection::exception::IOException(u"Could not write the resource bundle");
+    }
+}
+
+ResourceBundle::~ResourceBundle()
+{
+}
+
+const char* ResourceBundle::getSection(::std::u16string_view path, size_t* size) const
+{
+    return getNormalizedSection(normalizePath(path), size);
+}
+
+const char* ResourceBundle::getNormalizedSection(::std::string_view normalizedPath, size_t* size) const
+{
+    if (!normalizedPath.starts_with(mountPrefix)) {
+        return nullptr;
+    }
+    auto section = sections.find(normalizedPath.substr(mountPrefix.length()));
+    if (section == sections.end()) {
+        return nullptr;
+    }
+    *npc(size) = section->second.length();
+    return section->second.data();
+}
+
+void ResourceBundle::registerBundle(const ::std::u16string& bundlePath, const ::std::u16string& mountPath)
+{
+    auto bundle = new ResourceBundle(bundlePath, mountPath);
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    auto registeredBundles = REGISTERED_BUNDLES().load(::std::memory_order_relaxed);
+    auto updatedBundles = new RegisteredBundles();
+    updatedBundles->reserve(npc(registeredBundles)->size() + 1);
+    // Later registrations take precedence, so that an updated bundle can override an older one.
+    updatedBundles->push_back(bundle);
+    updatedBundles->insert(updatedBundles->end(), registeredBundles->begin(), registeredBundles->end());
+    // The previous snapshot is intentionally not deleted. Readers may still be searching it,
+    // and it is bounded by the small number of bundles that are ever registered.
+    REGISTERED_BUNDLES().store(updatedBundles, ::std::memory_order_release);
+}
+
+bool ResourceBundle::unregisterBundle(const ::std::u16string& bundlePath)
+{
+    const auto normalizedBundlePath(normalizePath(bundlePath));
+    std::lock_guard<std::mutex> guard(CLASS_MUTEX());
+    auto registeredBundles = REGISTERED_BUNDLES().load(::std::memory_order_relaxed);
+    auto updatedBundles = new RegisteredBundles();
+    for (const auto bundle : *npc(registeredBundles)) {
+        if (npc(bundle)->bundlePath != normalizedBundlePath) {
+            updatedBundles->push_back(bundle);
+        }
+    }
+    if (updatedBundles->size() == registeredBundles->size()) {
+        delete updatedBundles;
+        return false;
+    }
+    // Neither the previous snapshot nor the unregistered bundles are deleted, for the same reason as in registerBundle.
+    REGISTERED_BUNDLES().store(updatedBundles, ::std::memory_order_release);
+    return true;
+}
+
+const char* ResourceBundle::findSection(::std::u16string_view path, size_t* size)
+{
+    auto registeredBundles = REGISTERED_BUNDLES().load(::std::memory_order_acquire);
+    // Avoid normalizing every path that is mapped when no bundle is used.
+    if (npc(registeredBundles)->empty()) {
+        return nullptr;
+    }
+    // The path is normalized once instead of once for every bundle.
+    const auto normalizedPath(normalizePath(path));
+    for (const auto bundle : *registeredBundles) {
+        auto section = npc(bundle)->getNormalizedSection(normalizedPath, size);
+        if (section != nullptr) {
+            return section;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace inflection::util
@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/util/fwd.hpp>
+#include <inflection/util/MemoryMappedFile.hpp>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <string_view>
+
+/**
+ * A single memory mapped file that contains the binary resources of any number of locales.
+ * The bundle starts with a table of contents that maps the path of each resource, relative to the directory that the
+ * bundle is mounted on, to a section of the bundle. Once a bundle is registered, a MemoryMappedFile for a path
+ * in that directory uses the section of the bundle instead of opening and mapping the file.
+ * <p>
+ * The file format is the header, the table of contents, the names of the sections, and then the sections.
+ * Each section starts on a multiple of SECTION_ALIGNMENT, which keeps the alignment that the resources were built with.
+ */
+class INFLECTION_INTERNAL_API inflection::util::ResourceBundle final
+{
+public:
+    /**
+     * @param bundlePath The path of the bundle file.
+     * @param mountPath The directory that the paths in the table of contents are relative to.
+     */
+    ResourceBundle(const ::std::u16string& bundlePath, const ::std::u16string& mountPath);
+    ~ResourceBundle();
+
+    /**
+     * Returns the section for the path, or nullptr when the path is not in this bundle.
+     * @param size Set to the size of the section.
+     */
+    const char* getSection(::std::u16string_view path, size_t* size) const;
+
+    /**
+     * Register a bundle for MemoryMappedFile to use. Registered bundles are never unmapped.
+     */
+    static void registerBundle(const ::std::u16string& bundlePath, const ::std::u16string& mountPath);
+    /**
+     * Stop using the bundles registered with the bundle path. They stay mapped, because the resources that were
+     * already loaded from them may still use their sections.
+     * @return true when a bundle was unregistered.
+     */
+    static bool unregisterBundle(const ::std::u16string& bundlePath);
+    /**
+     * Returns the section of a registered bundle for the path, or nullptr when no registered bundle contains it.
+     * This doesn't lock, and the path is only normalized when a bundle is registered.
+     * @param size Set to the size of the section.
+     */
+    static const char* findSection(::std::u16string_view path, size_t* size);
+
+    static constexpr int16_t OPTIONS = {  }; // Space reserved for options.
+    static constexpr int16_t ENDIANNESS_MARKER = 1;
+    static constexpr char MAGIC_MARKER[8] { "INFLBND" };
+    static constexpr int64_t VERSION { 1 }; // Bump this version if the binary file format changes.
+    static constexpr int64_t SECTION_ALIGNMENT { 4096 };
+
+    /**
+     * An entry of the table of contents. The name is UTF-8 with / as the directory separator.
+     */
+    struct Entry {
+        int64_t offset;
+        int64_t length;
+        int32_t nameOffset;
+        int32_t nameLength;
+    };
+
+    /**
+     * Write a bundle that contains the given files.
+     * @param sections The files to write, keyed by the name of the section, which is the path relative to the mount path
+     * with / as the directory separator.
+     * @throws IOException Thrown when a file can not be read.
+     */
+    static void write(::std::ostream& out, const ::std::map<::std::string, ::std::u16string>& sections);
+
+    /**
+     * Returns the path with the components normalized, and / as the directory separator.
+     */
+    static ::std::string normalizePath(::std::u16string_view path);
+
+private:
+    ResourceBundle(const ResourceBundle&) = delete;
+    ResourceBundle& operator=(const ResourceBundle&) = delete;
+
+    /**
+     * Same as getSection, but the path is already normalized with normalizePath.
+     */
+    const char* getNormalizedSection(::std::string_view normalizedPath, size_t* size) const;
+
+    MemoryMappedFile mappedFile;
+    ::std::string bundlePath {  };
+    ::std::string mountPrefix {  };
+    ::std::map<::std::string_view, ::std::string_view, ::std::less<>> sections {  };
+};
@@ -0,0 +1,31 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include <inflection/util/ShardedCounter.hpp>
+
+namespace inflection::util {
+
+ShardedCounter::ShardedCounter() = default;
+
+ShardedCounter::~ShardedCounter() = default;
+
+bool ShardedCounter::isZero() const
+{
+    for (const auto& shard : shards) {
+        // The acquire pairs with the release of the last reference, so that anything that the reference was used for
+        // happens before the counted object is destroyed.
+        if (shard.count.load(::std::memory_order_acquire) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+::std::atomic<int64_t>& ShardedCounter::getThreadShard()
+{
+    static ::std::atomic<int32_t> nextShard(0);
+    static thread_local int32_t threadShard = nextShard.fetch_add(1, ::std::memory_order_relaxed) % SHARD_COUNT;
+    return shards[threadShard].count;
+}
+
+} // namespace inflection::util
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/util/fwd.hpp>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A count of the ShardedCounter_Reference objects that were created from it. The count is split into shards on
+ * separate cache lines, and each thread starts its references in its own shard, so threads that create and destroy
+ * references at the same time don't write the same cache line.
+ * <p>
+ * A copy of a reference counts itself in the same shard as the original. That shard can't reach zero while the
+ * original exists, so once no new reference is created directly from the counter, isZero() stays true after it first
+ * returns true.
+ */
+class INFLECTION_INTERNAL_API inflection::util::ShardedCounter final
+{
+public:
+    ShardedCounter();
+    ~ShardedCounter();
+
+    /**
+     * Returns true when no reference of this counter exists.
+     */
+    bool isZero() const;
+
+private:
+    ShardedCounter(const ShardedCounter&) = delete;
+    ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+    ::std::atomic<int64_t>& getThreadShard();
+
+    static constexpr int32_t SHARD_COUNT = 16;
+    struct alignas(64) Shard {
+        ::std::atomic<int64_t> count { 0 };
+    };
+    Shard shards[SHARD_COUNT] {  };
+
+    friend class ShardedCounter_Reference;
+};
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include <inflection/util/ShardedCounter_Reference.hpp>
+
+#include <inflection/util/ShardedCounter.hpp>
+
+namespace inflection::util {
+
+ShardedCounter_Reference::ShardedCounter_Reference(ShardedCounter& counter)
+    : shard(&counter.getThreadShard())
+{
+    shard->fetch_add(1, ::std::memory_order_relaxed);
+}
+
+ShardedCounter_Reference::ShardedCounter_Reference(const ShardedCounter_Reference& other)
+    : shard(other.shard)
+{
+    if (shard != nullptr) {
+        // The other reference keeps the shard above zero, so this doesn't need to be ordered with isZero().
+        shard->fetch_add(1, ::std::memory_order_relaxed);
+    }
+}
+
+ShardedCounter_Reference::ShardedCounter_Reference(ShardedCounter_Reference&& other) noexcept
+    : shard(other.shard)
+{
+    other.shard = nullptr;
+}
+
+ShardedCounter_Reference::~ShardedCounter_Reference()
+{
+    if (shard != nullptr) {
+        shard->fetch_sub(1, ::std::memory_order_release);
+    }
+}
+
+bool ShardedCounter_Reference::isEmpty() const
+{
+    return shard == nullptr;
+}
+
+} // namespace inflection::util
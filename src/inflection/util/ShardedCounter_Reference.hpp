@@ -0,0 +1,40 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/util/fwd.hpp>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * Counts itself in a ShardedCounter for as long as it exists. A default constructed reference counts nothing.
+ */
+class INFLECTION_INTERNAL_API inflection::util::ShardedCounter_Reference final
+{
+public:
+    ShardedCounter_Reference() = default;
+    /**
+     * Count this reference in the shard of the current thread.
+     */
+    explicit ShardedCounter_Reference(ShardedCounter& counter);
+    /**
+     * Count this reference in the same shard as the other reference.
+     */
+    ShardedCounter_Reference(const ShardedCounter_Reference& other);
+    /**
+     * Take over the count of the other reference, which then counts nothing.
+     */
+    ShardedCounter_Reference(ShardedCounter_Reference&& other) noexcept;
+    ~ShardedCounter_Reference();
+
+    /**
+     * Returns true when this reference counts nothing.
+     */
+    bool isEmpty() const;
+
+private:
+    ShardedCounter_Reference& operator=(const ShardedCounter_Reference&) = delete;
+
+    ::std::atomic<int64_t>* shard {  };
+};
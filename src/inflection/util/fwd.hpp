@@ -26,7 +26,11 @@ namespace inflection
         class Logger;
         class LoggerConfig;
         class MemoryMappedFile;
+        class MemoryUsage;
+        class ResourceBundle;
         class ResourceLocator;
+        class ShardedCounter;
+        class ShardedCounter_Reference;
         class StringUtils;
         class StringViewUtils;
         class ULocale;
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include "AllocationCounter.hpp"
+
+#include <cstdlib>
+#include <new>
+
+static thread_local int32_t countingDepth = 0;
+static thread_local int64_t allocationCount = 0;
+
+AllocationCounter::AllocationCounter()
+{
+    if (countingDepth++ == 0) {
+        allocationCount = 0;
+    }
+}
+
+AllocationCounter::~AllocationCounter()
+{
+    countingDepth--;
+}
+
+int64_t AllocationCounter::getCount() const
+{
+    return allocationCount;
+}
+
+void* operator new(std::size_t size)
+{
+    if (countingDepth > 0) {
+        allocationCount++;
+    }
+    if (auto result = std::malloc(size == 0 ? 1 : size)) {
+        return result;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
@@ -0,0 +1,23 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Counts the allocations made by the current thread while it exists. The global allocator is replaced for this,
+ * which is why the allocation tests are in their own executable.
+ */
+class AllocationCounter final
+{
+public:
+    AllocationCounter();
+    ~AllocationCounter();
+
+    int64_t getCount() const;
+
+private:
+    AllocationCounter(const AllocationCounter&) = delete;
+    AllocationCounter& operator=(const AllocationCounter&) = delete;
+};
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include "AllocationCounter.hpp"
+
+#include <inflection/dialog/DictionaryLookupInflector.hpp>
+#include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/dictionary/Inflector.hpp>
+#include <inflection/util/LocaleUtils.hpp>
+#include <inflection/npc.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+
+TEST_CASE("InflectorAllocationTest#testVisitInflectionPatternsWithoutAllocation")
+{
+    const auto& inflector = ::inflection::dictionary::Inflector::getInflector(::inflection::util::LocaleUtils::US());
+    ::std::u16string_view word;
+    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> inflectionPatterns;
+    for (const auto candidate : {u"theory", u"idea", u"banana", u"happiness"}) {
+        inflectionPatterns.clear();
+        inflector.getInflectionPatternsForWord(candidate, inflectionPatterns);
+        if (inflectionPatterns.size() == 1) {
+            word = candidate;
+            break;
+        }
+    }
+    REQUIRE_FALSE(word.empty());
+
+    int32_t patternCount = 0;
+    int32_t inflectionCount = 0;
+    const auto visitor = [&patternCount, &inflectionCount](const ::inflection::dictionary::Inflector_InflectionPattern& inflectionPattern) {
+        patternCount++;
+        inflectionCount += inflectionPattern.numInflections();
+        return true;
+    };
+    // The first lookup of a thread creates its thread local state.
+    inflector.visitInflectionPatternsForWord(word, visitor);
+    patternCount = 0;
+    inflectionCount = 0;
+
+    int64_t allocationCount = 0;
+    {
+        AllocationCounter allocationCounter;
+        inflector.visitInflectionPatternsForWord(word, visitor);
+        allocationCount = allocationCounter.getCount();
+    }
+
+    REQUIRE(patternCount == 1);
+    REQUIRE(inflectionCount == inflectionPatterns.front().numInflections());
+    REQUIRE(allocationCount == 0);
+}
+
+TEST_CASE("InflectorAllocationTest#testDictionaryLookupInflectorWithoutContainerAllocation")
+{
+    const auto& locale = ::inflection::util::LocaleUtils::US();
+    const auto& inflector = ::inflection::dictionary::Inflector::getInflector(locale);
+    const auto& dictionary = *npc(::inflection::dictionary::DictionaryMetaData::createDictionary(locale));
+    // The words are short enough that their lowercased copy is not allocated.
+    ::std::u16string_view word;
+    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> inflectionPatterns;
+    for (const auto candidate : {u"theory", u"idea", u"banana"}) {
+        inflectionPatterns.clear();
+        inflector.getInflectionPatternsForWord(candidate, inflectionPatterns);
+        if (inflectionPatterns.size() == 1) {
+            word = candidate;
+            break;
+        }
+    }
+    REQUIRE_FALSE(word.empty());
+    int64_t wordGrammemes = 0;
+    REQUIRE(dictionary.getCombinedBinaryType(&wordGrammemes, word) != nullptr);
+    const ::std::vector<::std::u16string> constraints({u"plural"});
+
+    ::inflection::dialog::DictionaryLookupInflector dictionaryLookupInflector(locale);
+    // The first inflection of a thread creates its thread local state.
+    const auto expected(dictionaryLookupInflector.inflect(word, wordGrammemes, constraints));
+    REQUIRE(expected.has_value());
+
+    // The allocations that the dictionary makes for one inflection: the constraints, the inflections of the surface form,
+    // and the reinflected word.
+    ::std::u16string reinflected;
+    int64_t dictionaryAllocationCount = 0;
+    {
+        AllocationCounter allocationCounter;
+        int64_t constraintGrammemes = 0;
+        dictionary.getBinaryProperties(&constraintGrammemes, constraints);
+        const auto inflections(inflectionPatterns.front().inflectionsForSurfaceForm(word, wordGrammemes));
+        if (!inflections.empty()) {
+            reinflected = inflections.front().getInflectionPattern().reinflectWithOptionalConstraints(inflections.front().getGrammemes(), constraintGrammemes, {}, word);
+        }
+        dictionaryAllocationCount = allocationCounter.getCount();
+    }
+    REQUIRE(reinflected == *expected);
+
+    // The dialog layer adds no allocation of its own, such as a container for the patterns or the candidates.
+    ::std::optional<::std::u16string> inflected;
+    int64_t allocationCount = 0;
+    {
+        AllocationCounter allocationCounter;
+        inflected = dictionaryLookupInflector.inflect(word, wordGrammemes, constraints);
+        allocationCount = allocationCounter.getCount();
+    }
+    REQUIRE(inflected == expected);
+    REQUIRE(allocationCount <= dictionaryAllocationCount);
+}
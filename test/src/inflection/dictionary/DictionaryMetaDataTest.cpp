@@ -5,12 +5,18 @@
 #include "catch2/catch_test_macros.hpp"
 
 #include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/dictionary/Inflector.hpp>
+#include <inflection/dictionary/Inflector_Paradigm.hpp>
+#include <inflection/exception/IllegalArgumentException.hpp>
 #include <inflection/util/LocaleUtils.hpp>
 #include <inflection/util/LogToString.hpp>
+#include <inflection/util/MemoryUsage.hpp>
 #include <inflection/util/StringUtils.hpp>
+#include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/ULocale.hpp>
 #include <inflection/npc.hpp>
 #include <algorithm>
+#include <set>
 
 bool contains(const ::std::vector<::std::u16string>& list, const ::std::u16string& toFind) {
     return ::std::any_of(list.begin(), list.end(), [&toFind](const auto &item){
@@ -64,6 +70,96 @@ TEST_CASE("DictionaryMetaDataTest#testUnknown")
     REQUIRE(result.size() == 0);
 }
 
+TEST_CASE("DictionaryMetaDataTest#testPropertyValuesBuffer")
+{
+    auto dictionary = inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::US());
+    ::std::u16string valuesBuffer;
+    ::std::vector<::std::u16string_view> values;
+    for (const auto& [word, property] : ::std::vector<::std::pair<::std::u16string_view, ::std::u16string_view>>{{u"mice", u"inflection"}, {u"theories", u"inflection"}, {u"Mouse", u"inflection"}, {u"Qapla", u"inflection"}}) {
+        auto expected(npc(dictionary)->getPropertyValues(word, property));
+        REQUIRE(npc(dictionary)->getPropertyValues(&valuesBuffer, &values, word, property) == !expected.empty());
+        REQUIRE(values == ::std::vector<::std::u16string_view>(expected.begin(), expected.end()));
+    }
+}
+
+TEST_CASE("DictionaryMetaDataTest#testUTF8Lookup")
+{
+    auto dictionary = inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::RUSSIAN());
+    ::std::string valuesBuffer;
+    ::std::vector<::std::string_view> values;
+    for (const auto word : {u"анатолий", u"Анатолий", u"книга", u"Qapla"}) {
+        auto utf8Word(::inflection::util::StringViewUtils::to_string(word));
+        int64_t expectedType = 0;
+        int64_t actualType = 0;
+        REQUIRE((npc(dictionary)->getCombinedBinaryType(&expectedType, word) == nullptr) == (npc(dictionary)->getCombinedBinaryType(&actualType, utf8Word) == nullptr));
+        REQUIRE(expectedType == actualType);
+        REQUIRE(npc(dictionary)->isKnownWord(word) == npc(dictionary)->isKnownWord(utf8Word));
+
+        auto expected(npc(dictionary)->getPropertyValues(word, u"inflection"));
+        REQUIRE(npc(dictionary)->getPropertyValues(&valuesBuffer, &values, utf8Word, u"inflection") == !expected.empty());
+        REQUIRE(values.size() == expected.size());
+        for (size_t idx = 0; idx < values.size(); idx++) {
+            REQUIRE(::inflection::util::StringViewUtils::to_u16string(values[idx]) == expected[idx]);
+        }
+    }
+}
+
+TEST_CASE("DictionaryMetaDataTest#testCombinedBinaryTypes")
+{
+    auto dictionary = inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::US());
+    const ::std::vector<::std::u16string_view> words({u"mice", u"Paris", u"paris", u"HOUR", u"HoUr", u"Bizzaro", u"bizzaro unknown word", u"", u"head"});
+    ::std::vector<int64_t> types(words.size());
+    npc(dictionary)->getCombinedBinaryTypes(types, words);
+    for (size_t idx = 0; idx < words.size(); idx++) {
+        int64_t expected = 0;
+        npc(dictionary)->getCombinedBinaryType(&expected, words[idx]);
+        REQUIRE(types[idx] == expected);
+    }
+    ::std::vector<int64_t> tooFewTypes(words.size() - 1);
+    REQUIRE_THROWS(npc(dictionary)->getCombinedBinaryTypes(tooFewTypes, words));
+}
+
+TEST_CASE("DictionaryMetaDataTest#testCaseFoldedLookup")
+{
+    auto dictionary = inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::US());
+    for (const auto& [lowercaseWord, caseFoldedWord] : ::std::vector<::std::pair<::std::u16string_view, ::std::u16string_view>>({
+        {u"mice", u"Mice"},
+        {u"mice", u"MICE"},
+        {u"hour", u"HOUR"},
+        {u"head", u"Head"},
+        // These are not in the case folded words, so they are found by lowercasing them.
+        {u"mice", u"MiCe"},
+        {u"head", u"hEAD"},
+    })) {
+        int64_t expectedType = 0;
+        int64_t actualType = 0;
+        REQUIRE(npc(dictionary)->getCombinedBinaryType(&expectedType, lowercaseWord) != nullptr);
+        REQUIRE(npc(dictionary)->getCombinedBinaryType(&actualType, caseFoldedWord) != nullptr);
+        REQUIRE(expectedType == actualType);
+        REQUIRE(npc(dictionary)->isKnownWord(caseFoldedWord));
+        REQUIRE(npc(dictionary)->getPropertyValues(lowercaseWord, u"inflection") == npc(dictionary)->getPropertyValues(caseFoldedWord, u"inflection"));
+    }
+}
+
+TEST_CASE("DictionaryMetaDataTest#testMemoryUsage")
+{
+    auto dictionary = inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::US());
+    ::inflection::util::MemoryUsage memoryUsage;
+    npc(dictionary)->getMemoryUsage(&memoryUsage);
+    REQUIRE(!memoryUsage.getSections().empty());
+    REQUIRE(memoryUsage.getMappedBytes() > 0);
+    REQUIRE(memoryUsage.getResidentBytes() <= memoryUsage.getMappedBytes());
+    for (const auto& section : memoryUsage.getSections()) {
+        REQUIRE(!section.name.empty());
+        REQUIRE(section.residentBytes <= section.mappedBytes);
+    }
+
+    ::inflection::util::MemoryUsage cacheUsage;
+    inflection::dictionary::DictionaryMetaData::getCacheMemoryUsage(&cacheUsage);
+    REQUIRE(cacheUsage.getHeapBytes() > 0);
+    REQUIRE(cacheUsage.getMappedBytes() == 0);
+}
+
 TEST_CASE("DictionaryMetaDataTest#testKorean")
 {
     auto dictionary = inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::KOREA());
@@ -129,6 +225,29 @@ TEST_CASE("DictionaryMetaDataTest#testProperties")
     }
 }
 
+TEST_CASE("DictionaryMetaDataTest#testBinaryPropertiesOfEach")
+{
+    auto dictionary = npc(inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::ENGLISH()));
+    const ::std::vector<::std::u16string> properties({u"noun", u"bizzaro unknown property", u"singular", u"plural", u""});
+    ::std::vector<int64_t> values;
+    dictionary->getBinaryPropertiesOfEach(&values, properties);
+    REQUIRE(values.size() == properties.size());
+    REQUIRE(values[0] == dictionary->getBinaryProperties({u"noun"}));
+    REQUIRE(values[1] == 0);
+    REQUIRE(values[2] == dictionary->getBinaryProperties({u"singular"}));
+    REQUIRE(values[3] == dictionary->getBinaryProperties({u"plural"}));
+    REQUIRE(values[4] == 0);
+    REQUIRE((values[0] | values[2] | values[3]) == dictionary->getBinaryProperties({u"noun", u"singular", u"plural"}));
+    for (size_t idx = 0; idx < values.size(); idx++) {
+        if (values[idx] != 0) {
+            REQUIRE(dictionary->getPropertyName(values[idx]) == properties[idx]);
+        }
+    }
+
+    dictionary->getBinaryPropertiesOfEach(&values, {});
+    REQUIRE(values.empty());
+}
+
 TEST_CASE("DictionaryMetaDataTest#testPropertyNames")
 {
     // If this triggers, then there was probably a bad parse of the dictionary.
@@ -159,6 +278,191 @@ TEST_CASE("DictionaryMetaDataTest#testKnownWords")
     REQUIRE(catFound);
 }
 
+TEST_CASE("DictionaryMetaDataTest#testPartitionedKnownWords")
+{
+    auto dictionary = npc(inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::ENGLISH()));
+    ::std::set<::std::u16string> allWords;
+    for (const auto& word : dictionary->getKnownWords()) {
+        allWords.insert(word);
+    }
+    constexpr int32_t partitionCount = 3;
+    ::std::set<::std::u16string> partitionedWords;
+    int32_t partitionedWordsCount = 0;
+    for (int32_t partition = 0; partition < partitionCount; partition++) {
+        for (const auto& word : dictionary->getKnownWords(partition, partitionCount)) {
+            REQUIRE(!word.empty());
+            partitionedWords.insert(word);
+            partitionedWordsCount++;
+        }
+    }
+    REQUIRE(int32_t(allWords.size()) == partitionedWordsCount);
+    REQUIRE(allWords == partitionedWords);
+
+    // The same part has the same words every time.
+    auto firstWord = *dictionary->getKnownWords(1, partitionCount);
+    REQUIRE(firstWord == *dictionary->getKnownWords(1, partitionCount));
+
+    REQUIRE_THROWS_AS(dictionary->getKnownWords(partitionCount, partitionCount), ::inflection::exception::IllegalArgumentException);
+    REQUIRE_THROWS_AS(dictionary->getKnownWords(0, 0), ::inflection::exception::IllegalArgumentException);
+}
+
+TEST_CASE("DictionaryMetaDataTest#testPrefixSearch")
+{
+    auto dictionary = npc(inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::ENGLISH()));
+    ::std::vector<::std::u16string> words;
+    auto collect = [&words](std::u16string_view word) {
+        words.emplace_back(word);
+        return true;
+    };
+
+    dictionary->forEachKnownWordWithPrefix(u"hou", 0, collect);
+    REQUIRE(contains(words, u"hour"));
+    for (const auto& word : words) {
+        REQUIRE(word.starts_with(u"hou"));
+        REQUIRE(dictionary->isKnownWord(word));
+    }
+    auto allWordsCount = words.size();
+
+    int64_t vowelStart = 0;
+    npc(dictionary->getBinaryProperties(&vowelStart, {u"vowel-start"}));
+    words.clear();
+    dictionary->forEachKnownWordWithPrefix(u"hou", vowelStart, collect);
+    REQUIRE(words.size() < allWordsCount);
+    REQUIRE(contains(words, u"hour"));
+    for (const auto& word : words) {
+        REQUIRE(dictionary->hasAllProperties(word, vowelStart));
+    }
+
+    words.clear();
+    dictionary->forEachKnownWordPrefixOf(u"hours of work", 0, collect);
+    REQUIRE(contains(words, u"hour"));
+    for (size_t idx = 0; idx < words.size(); idx++) {
+        REQUIRE(::std::u16string_view(u"hours of work").starts_with(words[idx]));
+        if (idx > 0) {
+            REQUIRE(words[idx - 1].length() < words[idx].length());
+        }
+    }
+
+    // Stop after the first word.
+    words.clear();
+    dictionary->forEachKnownWordWithPrefix(u"hou", 0, [&words](std::u16string_view word) {
+        words.emplace_back(word);
+        return false;
+    });
+    REQUIRE(words.size() == 1);
+
+    words.clear();
+    dictionary->forEachKnownWordWithPrefix(u"bizzaro unknown word", 0, collect);
+    dictionary->forEachKnownWordPrefixOf(u"", 0, collect);
+    REQUIRE(words.empty());
+}
+
+TEST_CASE("DictionaryMetaDataTest#testWordsForLemma")
+{
+    auto dictionary = npc(inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::US()));
+    ::std::vector<::std::u16string> words;
+    REQUIRE(dictionary->getKnownWordsForLemma(&words, u"theory"));
+    REQUIRE(contains(words, u"theory"));
+    REQUIRE(contains(words, u"theories"));
+
+    words.clear();
+    REQUIRE(dictionary->getKnownWordsForLemma(&words, u"mouse"));
+    REQUIRE(contains(words, u"mice"));
+
+    words.clear();
+    REQUIRE(dictionary->getKnownWordsForLemma(&words, u"bizzaro unknown word"));
+    REQUIRE(words.empty());
+
+    const auto& inflector = ::inflection::dictionary::Inflector::getInflector(::inflection::util::LocaleUtils::US());
+    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> inflectionPatterns;
+    inflector.getInflectionPatternsForWord(u"theories", inflectionPatterns);
+    REQUIRE_FALSE(inflectionPatterns.empty());
+    bool found = false;
+    for (const auto& inflectionPattern : inflectionPatterns) {
+        words.clear();
+        REQUIRE(inflector.getWordsForLemma(&words, u"theory", inflectionPattern));
+        found |= contains(words, u"theories");
+    }
+    REQUIRE(found);
+}
+
+TEST_CASE("DictionaryMetaDataTest#testReinflect")
+{
+    auto dictionary = inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::US());
+    int64_t singular = 0;
+    int64_t plural = 0;
+    REQUIRE(npc(dictionary)->getBinaryProperties(&singular, {u"singular"}) != nullptr);
+    REQUIRE(npc(dictionary)->getBinaryProperties(&plural, {u"plural"}) != nullptr);
+
+    const auto& inflector = ::inflection::dictionary::Inflector::getInflector(::inflection::util::LocaleUtils::US());
+    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> inflectionPatterns;
+    inflector.getInflectionPatternsForWord(u"theory", inflectionPatterns);
+    REQUIRE_FALSE(inflectionPatterns.empty());
+    bool foundUnknownGrammemes = false;
+    bool foundKnownGrammemes = false;
+    for (const auto& inflectionPattern : inflectionPatterns) {
+        // The first can be an exact grammeme match, and the second needs the scoring of the partial matches.
+        foundUnknownGrammemes |= inflectionPattern.reinflect(0, plural, u"theory") == u"theories";
+        foundKnownGrammemes |= inflectionPattern.reinflect(singular, plural, u"theory") == u"theories";
+        REQUIRE(inflectionPattern.reinflect(plural, plural, u"theories") == u"theories");
+    }
+    REQUIRE(foundUnknownGrammemes);
+    REQUIRE(foundKnownGrammemes);
+}
+
+TEST_CASE("DictionaryMetaDataTest#testParadigm")
+{
+    auto dictionary = inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::US());
+    int64_t plural = 0;
+    REQUIRE(npc(dictionary)->getBinaryProperties(&plural, {u"plural"}) != nullptr);
+
+    const auto& inflector = ::inflection::dictionary::Inflector::getInflector(::inflection::util::LocaleUtils::US());
+    ::inflection::dictionary::Inflector_Paradigm paradigm;
+    REQUIRE(inflector.getParadigm(&paradigm, u"theory"));
+    bool foundPlural = false;
+    for (int32_t idx = 0; idx < paradigm.size(); idx++) {
+        foundPlural |= paradigm.getSurfaceForm(idx) == u"theories" && (paradigm.getGrammemes(idx) & plural) == plural;
+    }
+    REQUIRE(foundPlural);
+
+    // Each form is the same as inflecting the lemma with each inflection of the pattern.
+    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> inflectionPatterns;
+    inflector.getInflectionPatternsForWord(u"mouse", inflectionPatterns);
+    REQUIRE_FALSE(inflectionPatterns.empty());
+    paradigm.clear();
+    REQUIRE(paradigm.empty());
+    inflectionPatterns.front().inflectParadigm(&paradigm, u"mouse");
+    const auto inflections(inflectionPatterns.front().constrain({}, false));
+    REQUIRE(paradigm.size() == int32_t(inflections.size()));
+    REQUIRE(paradigm.getPatternCount() == 1);
+    REQUIRE(paradigm.getPatternIdentifier(0) == inflectionPatterns.front().getIdentifier());
+    for (int32_t idx = 0; idx < paradigm.size(); idx++) {
+        REQUIRE(paradigm.getSurfaceForm(idx) == inflections[idx].inflect(u"mouse"));
+        REQUIRE(paradigm.getGrammemes(idx) == inflections[idx].getGrammemes());
+        REQUIRE(paradigm.getPatternIndex(idx) == 0);
+    }
+
+    // The forms of each pattern of the lemma are contiguous and are attributed to that pattern.
+    inflectionPatterns.clear();
+    inflector.getInflectionPatternsForWord(u"theory", inflectionPatterns);
+    paradigm.clear();
+    REQUIRE(inflector.getParadigm(&paradigm, u"theory"));
+    REQUIRE(paradigm.getPatternCount() == int32_t(inflectionPatterns.size()));
+    int32_t formIdx = 0;
+    for (int32_t patternIdx = 0; patternIdx < paradigm.getPatternCount(); patternIdx++) {
+        REQUIRE(paradigm.getPatternIdentifier(patternIdx) == inflectionPatterns[patternIdx].getIdentifier());
+        for (int32_t count = 0; count < inflectionPatterns[patternIdx].numInflections(); count++, formIdx++) {
+            REQUIRE(paradigm.getPatternIndex(formIdx) == patternIdx);
+        }
+    }
+    REQUIRE(formIdx == paradigm.size());
+
+    paradigm.clear();
+    REQUIRE_FALSE(inflector.getParadigm(&paradigm, u"bizzaro unknown word"));
+    REQUIRE(paradigm.empty());
+    REQUIRE(paradigm.getPatternCount() == 0);
+}
+
 TEST_CASE("DictionaryMetaDataTest#testFallback")
 {
     auto fallbackDictionary = inflection::dictionary::DictionaryMetaData::createDictionary(::inflection::util::LocaleUtils::US());
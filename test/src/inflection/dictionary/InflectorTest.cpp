@@ -0,0 +1,26 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <inflection/dictionary/Inflector.hpp>
+#include <inflection/util/LocaleUtils.hpp>
+#include <string>
+#include <vector>
+
+TEST_CASE("InflectorTest#testVisitInflectionPatternsStops")
+{
+    const auto& inflector = ::inflection::dictionary::Inflector::getInflector(::inflection::util::LocaleUtils::US());
+    int32_t patternCount = 0;
+    REQUIRE_FALSE(inflector.visitInflectionPatternsForWord(u"theory", [&patternCount](const ::inflection::dictionary::Inflector_InflectionPattern&) {
+        patternCount++;
+        return false;
+    }));
+    REQUIRE(patternCount == 1);
+    REQUIRE(inflector.visitInflectionPatternsForWord(u"bizzaro unknown word", [](const ::inflection::dictionary::Inflector_InflectionPattern&) {
+        return false;
+    }));
+    REQUIRE(inflector.visitInflectionPatternsForWord(::std::string_view("theory"), [](const ::inflection::dictionary::Inflector_InflectionPattern&) {
+        return true;
+    }));
+}
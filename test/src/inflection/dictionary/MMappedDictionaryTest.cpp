@@ -6,7 +6,9 @@
 #include <inflection/dictionary/metadata/CompressedArray.hpp>
 #include <inflection/dictionary/metadata/StringContainer.hpp>
 #include <inflection/dictionary/metadata/StringArrayContainer.hpp>
+#include <inflection/dictionary/metadata/KeyWeights.hpp>
 #include <inflection/dictionary/metadata/MarisaTrie.hpp>
+#include <inflection/dictionary/metadata/MembershipFilter.hpp>
 #include <inflection/dictionary/DictionaryMetaData_MMappedDictionary.hpp>
 #include <inflection/util/StringUtils.hpp>
 #include <inflection/exception/IncompatibleVersionException.hpp>
@@ -91,10 +93,107 @@ TEST_CASE("MMappedDictionaryTest#testTrie")
     inflection::util::MemoryMappedFile mappedFile(string.data(), trieSize);
     trie = new inflection::dictionary::metadata::MarisaTrie<int64_t>(&mappedFile);
     ensureEquivalence(wordsToTypes, trie);
+    ::std::u16string key(u"previous contents");
+    for (const auto& entry : wordsToTypes) {
+        auto keyId = trie->getKeyId(entry.first);
+        REQUIRE(trie->getKey(&key, keyId) == int32_t(entry.first.length()));
+        REQUIRE(key == entry.first);
+    }
     delete trie;
     REQUIRE_THROWS(mappedFile.read<int64_t>());
 }
 
+TEST_CASE("MMappedDictionaryTest#testWeightedTrie")
+{
+    ::std::map<::std::u16string_view, int64_t> wordsToTypes({
+        {u"abc", 292},
+        {u"abd", 7},
+        {u"def", 42},
+        {u"xyz", 1000}
+    });
+    ::inflection::dictionary::metadata::KeyWeights keyWeights({
+        {u"xyz", 1000.0f},
+        {u"abd", 10.0f},
+        {u"not a key", 5.0f},
+    });
+    REQUIRE(keyWeights.getWeight(u"xyz") == 1000.0f);
+    REQUIRE(keyWeights.getWeight(u"abc") == ::inflection::dictionary::metadata::KeyWeights::DEFAULT_WEIGHT);
+
+    // The weights only change the layout, so the same values are found.
+    ::inflection::dictionary::metadata::MarisaTrie<int64_t> trie(wordsToTypes, &keyWeights);
+    ensureEquivalence(wordsToTypes, &trie);
+    REQUIRE_FALSE(trie.find(u"not a key"));
+
+    ::std::ostringstream buffer;
+    trie.write(buffer);
+    auto string = buffer.str();
+    inflection::util::MemoryMappedFile mappedFile(string.data(), string.length());
+    ::inflection::dictionary::metadata::MarisaTrie<int64_t> mappedTrie(&mappedFile);
+    ensureEquivalence(wordsToTypes, &mappedTrie);
+}
+
+TEST_CASE("MMappedDictionaryTest#testTriePrefixes")
+{
+    ::std::map<::std::u16string_view, int64_t> wordsToTypes({
+        {u"", 1},
+        {u"ab", 2},
+        {u"abc", 3},
+        {u"b", 4}
+    });
+    ::inflection::dictionary::metadata::MarisaTrie<int64_t> trie(wordsToTypes);
+    ::std::u16string keyBuffer;
+    ::std::map<::std::u16string, int64_t> found;
+    auto collect = [&found](::std::u16string_view key, int64_t value) {
+        found.emplace(key, value);
+        return true;
+    };
+
+    // The empty key is skipped by both kinds of prefix search.
+    trie.forEachWithPrefix(u"", &keyBuffer, collect);
+    REQUIRE(found == ::std::map<::std::u16string, int64_t>({{u"ab", 2}, {u"abc", 3}, {u"b", 4}}));
+    found.clear();
+    trie.forEachWithPrefix(u"ab", &keyBuffer, collect);
+    REQUIRE(found == ::std::map<::std::u16string, int64_t>({{u"ab", 2}, {u"abc", 3}}));
+    found.clear();
+    trie.forEachPrefixOf(u"abcd", &keyBuffer, collect);
+    REQUIRE(found == ::std::map<::std::u16string, int64_t>({{u"ab", 2}, {u"abc", 3}}));
+}
+
+TEST_CASE("MMappedDictionaryTest#testKeyWeightsFile")
+{
+    auto path(createTemporaryFilePath());
+    auto cleanup = [&path]() noexcept { ::std::filesystem::remove(path); };
+    ::inflection::util::Finally<decltype(cleanup)> finally(cleanup);
+    {
+        ::std::ofstream output(path);
+        output << "# word\tcount\n"
+               << "the\t100\n"
+               << "\n"
+               << "of\t2.5\r\n"
+               << "the\t20\n";
+    }
+    ::inflection::dictionary::metadata::KeyWeights keyWeights(path.string());
+    REQUIRE(keyWeights.size() == 2);
+    REQUIRE(keyWeights.getWeight(u"the") == ::inflection::dictionary::metadata::KeyWeights::DEFAULT_WEIGHT + 120.0f);
+    REQUIRE(keyWeights.getWeight(u"of") == ::inflection::dictionary::metadata::KeyWeights::DEFAULT_WEIGHT + 2.5f);
+    REQUIRE(keyWeights.getWeight(u"and") == ::inflection::dictionary::metadata::KeyWeights::DEFAULT_WEIGHT);
+
+    {
+        ::std::ofstream output(path);
+        output << "the 100\n";
+    }
+    REQUIRE_THROWS_AS(::inflection::dictionary::metadata::KeyWeights(path.string()), ::inflection::exception::IOException);
+    for (const char* line : {"the\t100abc\n", "the\t\n", "the\t 100\n", "the\t-1\n", "the\tnan\n"}) {
+        {
+            ::std::ofstream output(path);
+            output << line;
+        }
+        REQUIRE_THROWS_AS(::inflection::dictionary::metadata::KeyWeights(path.string()), ::inflection::exception::IOException);
+    }
+    ::std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(::inflection::dictionary::metadata::KeyWeights(path.string()), ::inflection::exception::IOException);
+}
+
 TEST_CASE("MMappedDictionaryTest#testStringArrayContainer")
 {
     std::set<std::u16string_view> testData({u"a",u"cde",u"b"});
@@ -153,6 +252,65 @@ TEST_CASE("MMappedDictionaryTest#testCompressedArray")
     CHECK_THROWS(compressedArray.read(64));
 }
 
+TEST_CASE("MMappedDictionaryTest#testCompressedArrayReadRange")
+{
+    for (int32_t bitWidth : {1, 3, 7, 13, 32, 41, 63}) {
+        std::vector<int64_t> testData;
+        for (int64_t idx = 0; idx < 200; idx++) {
+            testData.emplace_back((idx * 0x9E3779B97F4A7C15LL) & ((int64_t(1) << bitWidth) - 1));
+        }
+        testData.emplace_back((int64_t(1) << bitWidth) - 1);
+        inflection::dictionary::metadata::CompressedArray<int64_t> compressedArray(testData);
+        std::vector<int64_t> result(testData.size());
+        compressedArray.readRange(result.data(), 0, int32_t(testData.size()));
+        CHECK(result == testData);
+        compressedArray.readRange(result.data(), 5, 100);
+        for (int32_t idx = 0; idx < 100; idx++) {
+            CHECK(result[idx] == compressedArray.read(5 + idx));
+        }
+        compressedArray.readRange(result.data(), int32_t(testData.size()), 0);
+        CHECK_THROWS(compressedArray.readRange(result.data(), -1, 2));
+        CHECK_THROWS(compressedArray.readRange(result.data(), 0, int32_t(testData.size()) + 64));
+    }
+}
+
+TEST_CASE("MMappedDictionaryTest#testMembershipFilter")
+{
+    ::std::vector<::std::u16string> words;
+    for (int32_t idx = 0; idx < 5000; idx++) {
+        words.emplace_back(u"word" + inflection::util::StringUtils::to_u16string(idx));
+    }
+    words.emplace_back(u"");
+    words.emplace_back(u"\u00e9t\u00e9");
+    words.emplace_back(u"\U0001F600");
+    ::std::set<::std::u16string_view> keys(words.begin(), words.end());
+    inflection::dictionary::metadata::MembershipFilter originalFilter(keys);
+    std::ostringstream buffer;
+    REQUIRE_NOTHROW(originalFilter.write(buffer));
+    auto string = buffer.str();
+    inflection::util::MemoryMappedFile mappedFile(string.data(), string.length());
+    inflection::dictionary::metadata::MembershipFilter filter(&mappedFile);
+
+    // Members are never rejected, in either encoding.
+    for (const auto& word : words) {
+        CHECK(originalFilter.mightContain(::std::u16string_view(word)));
+        CHECK(filter.mightContain(::std::u16string_view(word)));
+        CHECK(filter.mightContain(::std::string_view(inflection::util::StringUtils::to_string(word))));
+    }
+    // Most other strings are rejected.
+    int32_t falsePositives = 0;
+    for (int32_t idx = 0; idx < 5000; idx++) {
+        if (filter.mightContain(::std::u16string_view(u"other" + inflection::util::StringUtils::to_u16string(idx)))) {
+            falsePositives++;
+        }
+    }
+    CHECK(falsePositives < 250);
+    // Strings that are not well formed can not be rejected.
+    CHECK(filter.mightContain(::std::u16string_view(u"\xD800")));
+    CHECK(filter.mightContain(::std::string_view("\xff")));
+    REQUIRE_THROWS(mappedFile.read<int8_t>());
+}
+
 TEST_CASE("MMappedDictionaryTest#readInvalidFiles")
 {
     auto temporaryPath = createTemporaryFilePath();
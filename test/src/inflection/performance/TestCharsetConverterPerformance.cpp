@@ -0,0 +1,105 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include "PerformanceUtils.hpp"
+
+#include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/dictionary/metadata/CharsetConverter.hpp>
+#include <inflection/util/ULocale.hpp>
+#include <inflection/util/LocaleUtils.hpp>
+#include <inflection/npc.hpp>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+
+constexpr int32_t DEFAULT_MAXMIMUM_KEYS_TO_CONVERT = 250000;
+
+static int64_t CharsetConverterPerformanceEncode(const ::inflection::dictionary::metadata::CharsetConverter& converter, const std::vector<::std::u16string>& words, std::vector<::std::string>* encodedWords)
+{
+    encodedWords->clear();
+    encodedWords->reserve(words.size());
+    ::std::string encoded;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& word : words) {
+        converter.encode(&encoded, word);
+        encodedWords->emplace_back(encoded);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+static int64_t CharsetConverterPerformanceDecode(const ::inflection::dictionary::metadata::CharsetConverter& converter, const std::vector<::std::string>& encodedWords)
+{
+    ::std::u16string decoded;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& encodedWord : encodedWords) {
+        converter.decode(&decoded, encodedWord.data(), int32_t(encodedWord.length()));
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+TEST_CASE("TestCharsetConverterPerformance#testKeyConversion", "[.]")
+{
+    const std::vector<::inflection::util::ULocale> locales({
+        ::inflection::util::LocaleUtils::US(),
+        ::inflection::util::LocaleUtils::RUSSIAN(),
+        ::inflection::util::LocaleUtils::HINDI(),
+    });
+    const char* encodings[] = {"BOCU1", "UTF8", "UTF16LE"};
+
+    auto delimiter = ",";
+
+    PerfTable<std::ofstream> csvTable("testCharsetConverterPerformance.csv");
+    csvTable.writeRow([delimiter](std::ofstream& writer)
+    {
+        writer  << "locale"
+                << delimiter
+                << "encoding"
+                << delimiter
+                << "encode ms"
+                << delimiter
+                << "decode ms"
+                << delimiter
+                << "keys"
+                << std::endl;
+    });
+    ::std::vector<::std::u16string> words;
+    ::std::vector<::std::string> encodedWords;
+
+    for (const auto& locale : locales) {
+        words.clear();
+        for (const auto& word : npc(::inflection::dictionary::DictionaryMetaData::createDictionary(locale))->getKnownWords()) {
+            words.emplace_back(word);
+            if (int32_t(words.size()) >= DEFAULT_MAXMIMUM_KEYS_TO_CONVERT) {
+                break;
+            }
+        }
+        int32_t wordCount = int32_t(words.size());
+
+        for (const auto encoding : encodings) {
+            ::inflection::dictionary::metadata::CharsetConverter converter(encoding);
+            int64_t encodeTime = CharsetConverterPerformanceEncode(converter, words, &encodedWords);
+            int64_t decodeTime = CharsetConverterPerformanceDecode(converter, encodedWords);
+
+            csvTable.writeRow([&locale, encoding, encodeTime, decodeTime, delimiter, wordCount](std::ofstream& writer)
+            {
+                writer  << locale.getName()
+                        << delimiter
+                        << encoding
+                        << delimiter
+                        << encodeTime
+                        << delimiter
+                        << decodeTime
+                        << delimiter
+                        << wordCount
+                        << std::endl;
+            });
+        }
+    }
+}
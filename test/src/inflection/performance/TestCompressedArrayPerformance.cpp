@@ -0,0 +1,98 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include "PerformanceUtils.hpp"
+
+#include <inflection/dictionary/metadata/CompressedArray.hpp>
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <chrono>
+
+constexpr int32_t DEFAULT_COMPRESSED_ARRAY_SIZE = 1000000;
+constexpr int32_t DEFAULT_COMPRESSED_ARRAY_RANGE_LENGTH = 32;
+constexpr int32_t DEFAULT_COMPRESSED_ARRAY_PASSES = 20;
+
+static int64_t CompressedArrayPerformanceRead(const ::inflection::dictionary::metadata::CompressedArray<int64_t>& compressedArray, int32_t arraySize, int64_t* checksum)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int32_t pass = 0; pass < DEFAULT_COMPRESSED_ARRAY_PASSES; pass++) {
+        for (int32_t rangeStart = 0; rangeStart + DEFAULT_COMPRESSED_ARRAY_RANGE_LENGTH <= arraySize; rangeStart += DEFAULT_COMPRESSED_ARRAY_RANGE_LENGTH) {
+            for (int32_t idx = 0; idx < DEFAULT_COMPRESSED_ARRAY_RANGE_LENGTH; idx++) {
+                *checksum += compressedArray.read(rangeStart + idx);
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+static int64_t CompressedArrayPerformanceReadRange(const ::inflection::dictionary::metadata::CompressedArray<int64_t>& compressedArray, int32_t arraySize, int64_t* checksum)
+{
+    int64_t values[DEFAULT_COMPRESSED_ARRAY_RANGE_LENGTH];
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int32_t pass = 0; pass < DEFAULT_COMPRESSED_ARRAY_PASSES; pass++) {
+        for (int32_t rangeStart = 0; rangeStart + DEFAULT_COMPRESSED_ARRAY_RANGE_LENGTH <= arraySize; rangeStart += DEFAULT_COMPRESSED_ARRAY_RANGE_LENGTH) {
+            compressedArray.readRange(values, rangeStart, DEFAULT_COMPRESSED_ARRAY_RANGE_LENGTH);
+            for (auto value : values) {
+                *checksum += value;
+            }
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+/**
+ * The bit widths depend on the dictionary contents, so this covers the range of widths used by the
+ * property value maps, the data singletons and the inflection patterns.
+ */
+TEST_CASE("TestCompressedArrayPerformance#testReadRange", "[.]")
+{
+    auto delimiter = ",";
+
+    PerfTable<std::ofstream> csvTable("testCompressedArrayPerformance.csv");
+    csvTable.writeRow([delimiter](std::ofstream& writer)
+    {
+        writer  << "bit width"
+                << delimiter
+                << "read ms"
+                << delimiter
+                << "readRange ms"
+                << delimiter
+                << "values"
+                << std::endl;
+    });
+
+    for (int32_t bitWidth : {1, 2, 4, 7, 8, 11, 13, 16, 19, 24, 27, 32, 40, 48}) {
+        ::std::vector<int64_t> input;
+        input.reserve(DEFAULT_COMPRESSED_ARRAY_SIZE);
+        const int64_t mask = (int64_t(1) << bitWidth) - 1;
+        for (int64_t idx = 0; idx < DEFAULT_COMPRESSED_ARRAY_SIZE; idx++) {
+            input.emplace_back((idx * 0x9E3779B97F4A7C15LL) & mask);
+        }
+        input.back() = mask;
+        ::inflection::dictionary::metadata::CompressedArray<int64_t> compressedArray(input);
+        int64_t readChecksum = 0;
+        int64_t readRangeChecksum = 0;
+        int64_t readTime = CompressedArrayPerformanceRead(compressedArray, DEFAULT_COMPRESSED_ARRAY_SIZE, &readChecksum);
+        int64_t readRangeTime = CompressedArrayPerformanceReadRange(compressedArray, DEFAULT_COMPRESSED_ARRAY_SIZE, &readRangeChecksum);
+        REQUIRE(readChecksum == readRangeChecksum);
+
+        csvTable.writeRow([bitWidth, readTime, readRangeTime, delimiter](std::ofstream& writer)
+        {
+            writer  << bitWidth
+                    << delimiter
+                    << readTime
+                    << delimiter
+                    << readRangeTime
+                    << delimiter
+                    << DEFAULT_COMPRESSED_ARRAY_SIZE
+                    << std::endl;
+        });
+    }
+}
@@ -6,16 +6,30 @@
 #include "PerformanceUtils.hpp"
 
 #include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/dictionary/DictionaryMetaData_MMappedDictionary.hpp>
+#include <inflection/util/MemoryMappedFile.hpp>
+#include <inflection/util/MemoryUsage.hpp>
+#include <inflection/util/ResourceLocator.hpp>
+#include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/ULocale.hpp>
 #include <inflection/util/LocaleUtils.hpp>
 #include <inflection/npc.hpp>
 #include <marisa/iostream.h>
+#include <algorithm>
+#include <memory>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 #include <iostream>
 #include <fstream>
+#include <thread>
 #include <vector>
 #include <chrono>
 
 constexpr int32_t DEFAULT_MAXMIMUM_WORDS_TO_TEST = 250000;
+constexpr int32_t DEFAULT_CREATE_DICTIONARY_CALLS_PER_THREAD = 1000000;
+constexpr int32_t DEFAULT_FIRST_LOOKUPS_TO_TEST = 5000;
 
 int64_t DictionaryPerformanceInitialize(const inflection::util::ULocale& locale)
 {
@@ -39,6 +53,18 @@ int64_t DictionaryPerformanceGetCombinedBinaryType(const inflection::util::ULoca
     return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
 }
 
+int64_t DictionaryPerformanceGetCombinedBinaryTypes(const inflection::util::ULocale& locale, const std::vector<::std::u16string>& words)
+{
+    auto dictionary = ::inflection::dictionary::DictionaryMetaData::createDictionary(locale);
+    std::vector<::std::u16string_view> wordViews(words.begin(), words.end());
+    std::vector<int64_t> types(words.size());
+    auto start = std::chrono::high_resolution_clock::now();
+    dictionary->getCombinedBinaryTypes(types, wordViews);
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
 int64_t DictionaryPerformanceGetPropertyValues(const inflection::util::ULocale& locale, const std::vector<::std::u16string>& words)
 {
     ::std::map<::std::string, ::std::u16string, std::less<>> importantKeys({
@@ -109,9 +135,17 @@ TEST_CASE("TestDictionaryPerformance#testAllLanguages", "[.]")
                 << delimiter
                 << "getCombinedBinaryType ms"
                 << delimiter
+                << "getCombinedBinaryTypes ms"
+                << delimiter
                 << "getPropertyValues ms"
                 << delimiter
                 << "words"
+                << delimiter
+                << "mapped bytes"
+                << delimiter
+                << "resident bytes"
+                << delimiter
+                << "heap bytes"
                 << std::endl;
     });
     ::std::vector<::std::u16string> words;
@@ -138,9 +172,12 @@ TEST_CASE("TestDictionaryPerformance#testAllLanguages", "[.]")
         }
 
         int64_t getCombinedBinaryTypeTime = DictionaryPerformanceGetCombinedBinaryType(locale, words);
+        int64_t getCombinedBinaryTypesTime = DictionaryPerformanceGetCombinedBinaryTypes(locale, words);
         int64_t getPropertyValuesTime = DictionaryPerformanceGetPropertyValues(locale, words);
+        ::inflection::util::MemoryUsage memoryUsage;
+        npc(dictionary)->getMemoryUsage(&memoryUsage);
 
-        csvTable.writeRow([locale, initTime, getCombinedBinaryTypeTime, getPropertyValuesTime, delimiter, wordCount](std::ofstream& writer)
+        csvTable.writeRow([locale, initTime, getCombinedBinaryTypeTime, getCombinedBinaryTypesTime, getPropertyValuesTime, delimiter, wordCount, &memoryUsage](std::ofstream& writer)
         {
             writer  << locale.getName()
                     << delimiter
@@ -148,10 +185,269 @@ TEST_CASE("TestDictionaryPerformance#testAllLanguages", "[.]")
                     << delimiter
                     << getCombinedBinaryTypeTime
                     << delimiter
+                    << getCombinedBinaryTypesTime
+                    << delimiter
                     << getPropertyValuesTime
                     << delimiter
                     << wordCount
+                    << delimiter
+                    << memoryUsage.getMappedBytes()
+                    << delimiter
+                    << memoryUsage.getResidentBytes()
+                    << delimiter
+                    << memoryUsage.getHeapBytes()
+                    << std::endl;
+        });
+    }
+}
+
+int64_t DictionaryPerformanceCreateDictionaryContention(const std::vector<::inflection::util::ULocale>& locales, int32_t numThreads, bool lookUpWord)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int32_t threadIdx = 0; threadIdx < numThreads; threadIdx++) {
+        threads.emplace_back([&locales, threadIdx, lookUpWord]() {
+            auto localesSize = locales.size();
+            int64_t combinedType = 0;
+            for (int32_t i = 0; i < DEFAULT_CREATE_DICTIONARY_CALLS_PER_THREAD; i++) {
+                auto dictionary = npc(::inflection::dictionary::DictionaryMetaData::createDictionary(locales[(i + threadIdx) % localesSize]));
+                if (lookUpWord) {
+                    // The word doesn't matter. This measures how the lookups of the threads interfere with each other.
+                    dictionary->getCombinedBinaryType(&combinedType, u"a");
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+TEST_CASE("TestDictionaryPerformance#testCreateDictionaryContention", "[.]")
+{
+    auto ascendingLocales(::inflection::util::LocaleUtils::getSupportedLocaleList());
+    std::vector<::inflection::util::ULocale> locales(ascendingLocales.begin(), ascendingLocales.end());
+    for (const auto& locale : locales) {
+        // Only measure the lookups of dictionaries that are already loaded.
+        DictionaryPerformanceInitialize(locale);
+    }
+
+    auto delimiter = ",";
+
+    PerfTable<std::ofstream> csvTable("testCreateDictionaryContention.csv");
+    csvTable.writeRow([delimiter](std::ofstream& writer)
+    {
+        writer  << "threads"
+                << delimiter
+                << "createDictionary ms"
+                << delimiter
+                << "createDictionary and lookup ms"
+                << delimiter
+                << "calls per thread"
+                << std::endl;
+    });
+
+    auto maxThreads = std::max(int32_t(std::thread::hardware_concurrency()), 1);
+    for (int32_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+        int64_t contentionTime = DictionaryPerformanceCreateDictionaryContention(locales, numThreads, false);
+        int64_t lookupContentionTime = DictionaryPerformanceCreateDictionaryContention(locales, numThreads, true);
+
+        csvTable.writeRow([numThreads, contentionTime, lookupContentionTime, delimiter](std::ofstream& writer)
+        {
+            writer  << numThreads
+                    << delimiter
+                    << contentionTime
+                    << delimiter
+                    << lookupContentionTime
+                    << delimiter
+                    << DEFAULT_CREATE_DICTIONARY_CALLS_PER_THREAD
                     << std::endl;
         });
     }
 }
+
+int64_t DictionaryPerformancePartitionedScan(const ::inflection::dictionary::DictionaryMetaData& dictionary, int32_t numThreads, int64_t* totalLength)
+{
+    std::vector<int64_t> lengths(numThreads);
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int32_t threadIdx = 0; threadIdx < numThreads; threadIdx++) {
+        threads.emplace_back([&dictionary, &lengths, threadIdx, numThreads]() {
+            int64_t length = 0;
+            for (const auto& word : dictionary.getKnownWords(threadIdx, numThreads)) {
+                length += int64_t(word.length());
+            }
+            lengths[threadIdx] = length;
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    *totalLength = 0;
+    for (auto length : lengths) {
+        *totalLength += length;
+    }
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+TEST_CASE("TestDictionaryPerformance#testPartitionedScan", "[.]")
+{
+    ::std::set<::inflection::util::ULocale, ::std::less<>> locales;
+    auto ascendingLocales(::inflection::util::LocaleUtils::getSupportedLocaleList());
+    locales.insert(ascendingLocales.begin(), ascendingLocales.end());
+    const int32_t threadCounts[] = {1, 4, 16};
+
+    auto delimiter = ",";
+
+    PerfTable<std::ofstream> csvTable("testPartitionedScan.csv");
+    csvTable.writeRow([delimiter](std::ofstream& writer)
+    {
+        writer  << "locale"
+                << delimiter
+                << "threads"
+                << delimiter
+                << "scan ms"
+                << delimiter
+                << "words"
+                << delimiter
+                << "characters"
+                << std::endl;
+    });
+    ::std::set<::std::string> testedLanguages;
+
+    for (const auto& locale : locales) {
+        if (!testedLanguages.insert(::std::string(locale.getLanguage())).second) {
+            continue;
+        }
+        auto dictionary = npc(::inflection::dictionary::DictionaryMetaData::createDictionary(locale));
+        int32_t wordCount = dictionary->getKnownWordsSize();
+
+        for (auto numThreads : threadCounts) {
+            int64_t totalLength = 0;
+            int64_t scanTime = DictionaryPerformancePartitionedScan(*dictionary, numThreads, &totalLength);
+
+            csvTable.writeRow([&locale, numThreads, scanTime, wordCount, totalLength, delimiter](std::ofstream& writer)
+            {
+                writer  << locale.getLanguage()
+                        << delimiter
+                        << numThreads
+                        << delimiter
+                        << scanTime
+                        << delimiter
+                        << wordCount
+                        << delimiter
+                        << totalLength
+                        << std::endl;
+            });
+        }
+    }
+}
+
+static void DictionaryPerformanceEvictFromPageCache(const ::std::u16string& path)
+{
+#ifndef _WIN32
+    // Dropping the clean pages of the file makes the next access take major page faults, like right after a deploy.
+    int fd = open(::inflection::util::StringViewUtils::to_string(path).c_str(), O_RDONLY);
+    if (fd >= 0) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+#endif
+}
+
+TEST_CASE("TestDictionaryPerformance#testFirstLookupResidencyPolicy", "[.]")
+{
+    const ::std::vector<::std::pair<const char*, int32_t>> residencyPolicies({
+        {"lazy", ::inflection::util::MemoryMappedFile::RESIDENCY_LAZY},
+        {"prefault", ::inflection::util::MemoryMappedFile::RESIDENCY_PREFAULT},
+        {"random", ::inflection::util::MemoryMappedFile::RESIDENCY_RANDOM_ACCESS},
+        {"prefault+random", ::inflection::util::MemoryMappedFile::RESIDENCY_PREFAULT | ::inflection::util::MemoryMappedFile::RESIDENCY_RANDOM_ACCESS},
+        {"locked", ::inflection::util::MemoryMappedFile::RESIDENCY_LOCKED},
+        {"hugepages", ::inflection::util::MemoryMappedFile::RESIDENCY_HUGE_PAGES},
+    });
+    ::std::set<::inflection::util::ULocale, ::std::less<>> locales;
+    auto ascendingLocales(::inflection::util::LocaleUtils::getSupportedLocaleList());
+    locales.insert(ascendingLocales.begin(), ascendingLocales.end());
+
+    auto delimiter = ",";
+
+    PerfTable<std::ofstream> csvTable("testFirstLookupResidencyPolicy.csv");
+    csvTable.writeRow([delimiter](std::ofstream& writer)
+    {
+        writer  << "locale"
+                << delimiter
+                << "policy"
+                << delimiter
+                << "init ms"
+                << delimiter
+                << "first lookup us"
+                << delimiter
+                << "first lookups ms"
+                << delimiter
+                << "lookups"
+                << std::endl;
+    });
+    ::std::vector<::std::u16string> words;
+    ::std::set<::std::string> testedLanguages;
+
+    for (const auto& locale : locales) {
+        if (!testedLanguages.insert(::std::string(locale.getLanguage())).second) {
+            continue;
+        }
+        auto path(::inflection::util::ResourceLocator::getRootForLocale(locale) + u"/dictionary/mmappable_"
+            + ::inflection::util::StringViewUtils::to_u16string(locale.getLanguage()) + u".sdict");
+        words.clear();
+        // Spread the words across the dictionary to touch pages all over the file.
+        auto dictionary = ::inflection::dictionary::DictionaryMetaData::createDictionary(locale);
+        auto stride = std::max(npc(dictionary)->getKnownWordsSize() / DEFAULT_FIRST_LOOKUPS_TO_TEST, 1);
+        int32_t wordIdx = 0;
+        for (const auto& word : npc(dictionary)->getKnownWords()) {
+            if (wordIdx++ % stride == 0) {
+                words.emplace_back(word);
+            }
+        }
+        if (words.empty()) {
+            continue;
+        }
+        int32_t wordCount = int32_t(words.size());
+
+        for (const auto& [policyName, residencyPolicy] : residencyPolicies) {
+            DictionaryPerformanceEvictFromPageCache(path);
+            auto initStart = std::chrono::high_resolution_clock::now();
+            ::std::unique_ptr<::inflection::dictionary::DictionaryMetaData_MMappedDictionary> mappedDictionary(::inflection::dictionary::DictionaryMetaData_MMappedDictionary::createDictionary(path, residencyPolicy));
+            auto lookupStart = std::chrono::high_resolution_clock::now();
+            mappedDictionary->getWordType(words.front());
+            auto firstLookupEnd = std::chrono::high_resolution_clock::now();
+            for (const auto& word : words) {
+                mappedDictionary->getWordType(word);
+            }
+            auto lookupEnd = std::chrono::high_resolution_clock::now();
+
+            auto initTime = (int64_t)(std::chrono::duration<double, std::milli>(lookupStart - initStart).count());
+            auto firstLookupTime = (int64_t)(std::chrono::duration<double, std::micro>(firstLookupEnd - lookupStart).count());
+            auto lookupTime = (int64_t)(std::chrono::duration<double, std::milli>(lookupEnd - lookupStart).count());
+            csvTable.writeRow([&locale, policyName, initTime, firstLookupTime, lookupTime, delimiter, wordCount](std::ofstream& writer)
+            {
+                writer  << locale.getLanguage()
+                        << delimiter
+                        << policyName
+                        << delimiter
+                        << initTime
+                        << delimiter
+                        << firstLookupTime
+                        << delimiter
+                        << lookupTime
+                        << delimiter
+                        << wordCount
+                        << std::endl;
+            });
+        }
+    }
+}
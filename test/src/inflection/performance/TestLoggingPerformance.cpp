@@ -0,0 +1,121 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include "PerformanceUtils.hpp"
+
+#include <inflection/dialog/LocalizedCommonConceptFactoryProvider.hpp>
+#include <inflection/dialog/SemanticConcept.hpp>
+#include <inflection/dialog/SemanticFeatureModel.hpp>
+#include <inflection/dialog/SemanticValue.hpp>
+#include <inflection/dialog/SpeakableString.hpp>
+#include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/util/LocaleUtils.hpp>
+#include <inflection/util/Logger.hpp>
+#include <inflection/util/LoggerConfig.hpp>
+#include <inflection/util/ULocale.hpp>
+#include <inflection/util/Validate.hpp>
+#include <inflection/npc.hpp>
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+constexpr int32_t DEFAULT_MAXIMUM_WORDS_TO_LOG = 20000;
+
+INFLECTION_CBEGIN
+static void LoggingPerformanceDiscard(void*, ILogLevel, const char16_t*, const char16_t*)
+{
+}
+INFLECTION_CEND
+
+static int64_t LoggingPerformanceInflect(const ::inflection::dialog::SemanticFeatureModel& model, const ::std::vector<::std::u16string>& nouns)
+{
+    auto semanticFeature = model.getFeature(u"number");
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& word : nouns) {
+        ::inflection::dialog::SemanticConcept inflectableConcept(&model, ::inflection::dialog::SemanticValue(u"default", word), true);
+        if (semanticFeature != nullptr) {
+            inflectableConcept.putConstraint(*npc(semanticFeature), u"plural");
+        }
+        delete inflectableConcept.toSpeakableString();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+/**
+ * Compare the inflection time with trace logging disabled at runtime and enabled at runtime. The messages are built
+ * but discarded when enabled. Run this again in a build with the CMake option TRACE_LOGGING=OFF for the third mode,
+ * where the logging is removed at compile time.
+ */
+TEST_CASE("TestLoggingPerformance#testTraceModes", "[.]")
+{
+    const std::vector<::inflection::util::ULocale> locales({
+        ::inflection::util::LocaleUtils::RUSSIAN(),
+        ::inflection::util::LocaleUtils::GERMAN(),
+    });
+
+    auto delimiter = ",";
+
+    PerfTable<std::ofstream> csvTable("testLoggingPerformance.csv");
+    csvTable.writeRow([delimiter](std::ofstream& writer)
+    {
+        writer  << "locale"
+                << delimiter
+                << "compiled"
+                << delimiter
+                << "disabled ms"
+                << delimiter
+                << "enabled ms"
+                << delimiter
+                << "words"
+                << std::endl;
+    });
+
+    auto commonConceptFactoryProvider = ::inflection::dialog::LocalizedCommonConceptFactoryProvider::getDefaultCommonConceptFactoryProvider();
+    const auto originalLogLevel = ::inflection::util::LoggerConfig::getLogLevel();
+    static int32_t loggerContext = 0;
+    for (const auto& locale : locales) {
+        auto dictionary = npc(::inflection::dictionary::DictionaryMetaData::createDictionary(locale));
+        const auto& model = *npc(npc(npc(commonConceptFactoryProvider)->getCommonConceptFactory(locale))->getSemanticFeatureModel());
+        int64_t nounPOS = 0;
+        inflection::util::Validate::notNull(dictionary->getBinaryProperties(&nounPOS, {u"noun"}), locale.toString());
+
+        ::std::vector<::std::u16string> nouns;
+        for (const auto& word : dictionary->getKnownWords()) {
+            if (dictionary->hasAllProperties(word, nounPOS)) {
+                nouns.emplace_back(word);
+                if (int32_t(nouns.size()) >= DEFAULT_MAXIMUM_WORDS_TO_LOG) {
+                    break;
+                }
+            }
+        }
+
+        ::inflection::util::LoggerConfig::setLogLevel(ILOG_INFO);
+        int64_t disabledTime = LoggingPerformanceInflect(model, nouns);
+
+        ::inflection::util::LoggerConfig::registerLogger(&loggerContext, &LoggingPerformanceDiscard);
+        ::inflection::util::LoggerConfig::setLogLevel(ILOG_TRACE);
+        int64_t enabledTime = LoggingPerformanceInflect(model, nouns);
+        ::inflection::util::LoggerConfig::setLogLevel(originalLogLevel);
+        ::inflection::util::LoggerConfig::unregisterLogger(&loggerContext);
+
+        int32_t compiled = INFLECTION_TRACE_LOGGING;
+        int64_t words = int64_t(nouns.size());
+        csvTable.writeRow([&locale, delimiter, compiled, disabledTime, enabledTime, words](std::ofstream& writer)
+        {
+            writer  << locale.getName()
+                    << delimiter
+                    << compiled
+                    << delimiter
+                    << disabledTime
+                    << delimiter
+                    << enabledTime
+                    << delimiter
+                    << words
+                    << std::endl;
+        });
+    }
+}
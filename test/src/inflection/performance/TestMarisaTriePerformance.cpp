@@ -0,0 +1,125 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include "PerformanceUtils.hpp"
+
+#include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/dictionary/metadata/KeyWeights.hpp>
+#include <inflection/dictionary/metadata/MarisaTrie.hpp>
+#include <inflection/util/LocaleUtils.hpp>
+#include <inflection/util/ULocale.hpp>
+#include <inflection/npc.hpp>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <random>
+#include <vector>
+
+constexpr int32_t DEFAULT_MAXIMUM_TRIE_KEYS = 250000;
+constexpr int32_t DEFAULT_ZIPF_QUERIES = 2000000;
+
+static int64_t MarisaTriePerformanceLookup(const ::inflection::dictionary::metadata::MarisaTrie<int32_t>& trie, const ::std::vector<::std::u16string_view>& queries, int64_t* checksum)
+{
+    ::std::string encodedBuffer;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& query : queries) {
+        *checksum += trie.find(query, &encodedBuffer).value_or(0);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+/**
+ * Compare the lookup time of an unweighted trie with a trie that is weighted by the query frequencies. The queries
+ * follow a Zipf distribution over the words in a random order, which is close to the distribution of words in text.
+ */
+TEST_CASE("TestMarisaTriePerformance#testZipfLookup", "[.]")
+{
+    const std::vector<::inflection::util::ULocale> locales({
+        ::inflection::util::LocaleUtils::US(),
+        ::inflection::util::LocaleUtils::RUSSIAN(),
+        ::inflection::util::LocaleUtils::HINDI(),
+    });
+
+    auto delimiter = ",";
+
+    PerfTable<std::ofstream> csvTable("testMarisaTriePerformance.csv");
+    csvTable.writeRow([delimiter](std::ofstream& writer)
+    {
+        writer  << "locale"
+                << delimiter
+                << "unweighted ms"
+                << delimiter
+                << "weighted ms"
+                << delimiter
+                << "keys"
+                << delimiter
+                << "queries"
+                << std::endl;
+    });
+    ::std::vector<::std::u16string> words;
+
+    for (const auto& locale : locales) {
+        words.clear();
+        for (const auto& word : npc(::inflection::dictionary::DictionaryMetaData::createDictionary(locale))->getKnownWords()) {
+            words.emplace_back(word);
+            if (int32_t(words.size()) >= DEFAULT_MAXIMUM_TRIE_KEYS) {
+                break;
+            }
+        }
+        if (words.empty()) {
+            continue;
+        }
+        int32_t keyCount = int32_t(words.size());
+
+        // A fixed seed keeps the ranks and the queries the same for each run.
+        ::std::mt19937 generator(0x5eed);
+        ::std::shuffle(words.begin(), words.end(), generator);
+        ::std::vector<double> rankWeights;
+        rankWeights.reserve(words.size());
+        for (int32_t rank = 1; rank <= keyCount; rank++) {
+            rankWeights.emplace_back(1.0 / rank);
+        }
+        ::std::discrete_distribution<int32_t> zipf(rankWeights.begin(), rankWeights.end());
+        ::std::vector<::std::u16string_view> queries;
+        queries.reserve(DEFAULT_ZIPF_QUERIES);
+        ::std::map<::std::u16string, float, ::std::less<>> queryCounts;
+        for (int32_t idx = 0; idx < DEFAULT_ZIPF_QUERIES; idx++) {
+            const auto& word = words[zipf(generator)];
+            queries.emplace_back(word);
+            queryCounts[word] += 1.0f;
+        }
+
+        ::std::map<::std::u16string_view, int32_t> input;
+        for (int32_t idx = 0; idx < keyCount; idx++) {
+            input.emplace(words[idx], idx);
+        }
+        ::inflection::dictionary::metadata::KeyWeights keyWeights(queryCounts);
+        ::inflection::dictionary::metadata::MarisaTrie<int32_t> unweightedTrie(input);
+        ::inflection::dictionary::metadata::MarisaTrie<int32_t> weightedTrie(input, &keyWeights);
+
+        int64_t unweightedChecksum = 0;
+        int64_t weightedChecksum = 0;
+        int64_t unweightedTime = MarisaTriePerformanceLookup(unweightedTrie, queries, &unweightedChecksum);
+        int64_t weightedTime = MarisaTriePerformanceLookup(weightedTrie, queries, &weightedChecksum);
+        REQUIRE(unweightedChecksum == weightedChecksum);
+
+        csvTable.writeRow([&locale, unweightedTime, weightedTime, keyCount, delimiter](std::ofstream& writer)
+        {
+            writer  << locale.getName()
+                    << delimiter
+                    << unweightedTime
+                    << delimiter
+                    << weightedTime
+                    << delimiter
+                    << keyCount
+                    << delimiter
+                    << DEFAULT_ZIPF_QUERIES
+                    << std::endl;
+        });
+    }
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include "PerformanceUtils.hpp"
+
+#include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/dictionary/Inflector.hpp>
+#include <inflection/dictionary/Inflector_InflectionPattern.hpp>
+#include <inflection/util/LocaleUtils.hpp>
+#include <inflection/util/ULocale.hpp>
+#include <inflection/util/Validate.hpp>
+#include <inflection/npc.hpp>
+#include <chrono>
+#include <fstream>
+#include <vector>
+
+constexpr int32_t DEFAULT_MAXIMUM_WORDS_TO_REINFLECT = 100000;
+
+struct ReinflectionCandidate
+{
+    ::std::u16string word;
+    int64_t wordGrammemes;
+    ::inflection::dictionary::Inflector_InflectionPattern inflectionPattern;
+};
+
+static int64_t ReinflectionPerformanceReinflect(const ::std::vector<ReinflectionCandidate>& candidates, bool useWordGrammemes, int64_t toConstraints, int64_t* inflectedCount)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const auto& candidate : candidates) {
+        if (!candidate.inflectionPattern.reinflect(useWordGrammemes ? candidate.wordGrammemes : 0, toConstraints, candidate.word).empty()) {
+            (*inflectedCount)++;
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    return (int64_t)(std::chrono::duration<double, std::milli>(end - start).count());
+}
+
+/**
+ * Reinflect the nouns of languages with large paradigms. Without the word grammemes, the target grammemes are
+ * usually an exact match of an inflection, which the grammeme index finds without scoring the whole paradigm.
+ * With the word grammemes, most targets are partial matches that are scored. Compare the results with a dictionary
+ * that was built without --indexinflectiongrammemes to see the gain.
+ */
+TEST_CASE("TestReinflectionPerformance#testGrammemeIndex", "[.]")
+{
+    const std::vector<::std::pair<::inflection::util::ULocale, ::std::vector<::std::u16string>>> localeTargets({
+        {::inflection::util::LocaleUtils::RUSSIAN(), {u"plural", u"genitive"}},
+        {::inflection::util::LocaleUtils::FINNISH(), {u"plural", u"partitive"}},
+    });
+
+    auto delimiter = ",";
+
+    PerfTable<std::ofstream> csvTable("testReinflectionPerformance.csv");
+    csvTable.writeRow([delimiter](std::ofstream& writer)
+    {
+        writer  << "locale"
+                << delimiter
+                << "exact ms"
+                << delimiter
+                << "scored ms"
+                << delimiter
+                << "reinflections"
+                << delimiter
+                << "inflected"
+                << std::endl;
+    });
+
+    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> inflectionPatterns;
+    for (const auto& [locale, targets] : localeTargets) {
+        auto dictionary = npc(::inflection::dictionary::DictionaryMetaData::createDictionary(locale));
+        const auto& inflector = ::inflection::dictionary::Inflector::getInflector(locale);
+        int64_t nounPOS = 0;
+        int64_t toConstraints = 0;
+        inflection::util::Validate::notNull(dictionary->getBinaryProperties(&nounPOS, {u"noun"}), locale.toString());
+        inflection::util::Validate::notNull(dictionary->getBinaryProperties(&toConstraints, targets), locale.toString());
+
+        ::std::vector<ReinflectionCandidate> candidates;
+        for (const auto& word : dictionary->getKnownWords()) {
+            int64_t wordGrammemes = 0;
+            if (!dictionary->hasAllProperties(word, nounPOS) || dictionary->getCombinedBinaryType(&wordGrammemes, word) == nullptr) {
+                continue;
+            }
+            inflectionPatterns.clear();
+            inflector.getInflectionPatternsForWord(word, inflectionPatterns);
+            for (const auto& inflectionPattern : inflectionPatterns) {
+                candidates.push_back({word, wordGrammemes, inflectionPattern});
+            }
+            if (int32_t(candidates.size()) >= DEFAULT_MAXIMUM_WORDS_TO_REINFLECT) {
+                break;
+            }
+        }
+
+        int64_t exactInflected = 0;
+        int64_t scoredInflected = 0;
+        int64_t exactTime = ReinflectionPerformanceReinflect(candidates, false, toConstraints, &exactInflected);
+        int64_t scoredTime = ReinflectionPerformanceReinflect(candidates, true, toConstraints, &scoredInflected);
+        int64_t reinflections = int64_t(candidates.size());
+        int64_t inflected = exactInflected + scoredInflected;
+
+        csvTable.writeRow([&locale, delimiter, exactTime, scoredTime, reinflections, inflected](std::ofstream& writer)
+        {
+            writer  << locale.getName()
+                    << delimiter
+                    << exactTime
+                    << delimiter
+                    << scoredTime
+                    << delimiter
+                    << reinflections
+                    << delimiter
+                    << inflected
+                    << std::endl;
+        });
+    }
+}
@@ -5,14 +5,44 @@
 #include "catch2/catch_test_macros.hpp"
 
 #include <inflection/resources/DataRegistrationService.hpp>
+#include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/dictionary/Inflector.hpp>
+#include <inflection/dictionary/Inflector_InflectionPattern.hpp>
+#include <inflection/util/AutoFileDescriptor.hpp>
+#include <inflection/util/LocaleUtils.hpp>
+#include <inflection/util/ResourceBundle.hpp>
+#include <inflection/util/ResourceLocator.hpp>
+#include <inflection/util/StringViewUtils.hpp>
 #include <inflection/util/ULocale.hpp>
+#include <inflection/npc.hpp>
+#include <atomic>
+#include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <random>
+#include <thread>
+#include <vector>
 
 static std::string nativePath(const std::string& posixPath)
 {
     return std::filesystem::path(posixPath).make_preferred().string();
 }
 
+/**
+ * Creates a new temporary directory, so that test runs at the same time don't share files.
+ */
+static std::filesystem::path createUniqueTemporaryDirectory(const std::string& prefix)
+{
+    std::random_device randomDevice;
+    while (true) {
+        auto directory(std::filesystem::temp_directory_path() / (prefix + "-" + std::to_string(randomDevice())
+            + "-" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count())));
+        if (std::filesystem::create_directory(directory)) {
+            return directory;
+        }
+    }
+}
+
 TEST_CASE("DataRegistrationServiceTest#testEmpty")
 {
     REQUIRE(::inflection::resources::DataRegistrationService::getDataPathForLocale(inflection::util::ULocale("zz")).empty());
@@ -76,3 +106,93 @@ TEST_CASE("DataRegistrationServiceTest#testSomeLocalesPopulated")
     REQUIRE(nativePath("/test/path2") == ::inflection::resources::DataRegistrationService::getDataPathForLocale(inflection::util::ULocale("arc_IQ")));
     REQUIRE(nativePath("/test/path3") == ::inflection::resources::DataRegistrationService::getDataPathForLocale(inflection::util::ULocale("egy_EG")));
 }
+
+TEST_CASE("DataRegistrationServiceTest#testRegisterDictionary")
+{
+    const auto& english = ::inflection::util::LocaleUtils::ENGLISH();
+    auto dictionary = npc(::inflection::dictionary::DictionaryMetaData::createDictionary(english));
+    REQUIRE(dictionary->isKnownWord(u"hour"));
+    auto dictionaryDirectory = ::inflection::util::StringViewUtils::to_string(::inflection::util::ResourceLocator::getRootForLocale(english)) + "/dictionary/";
+
+    // Lookups continue without interruption while the dictionary is replaced.
+    ::std::atomic<bool> done(false);
+    ::std::atomic<int32_t> failedLookups(0);
+    ::std::thread reader([dictionary, &done, &failedLookups]() {
+        while (!done.load()) {
+            if (!dictionary->isKnownWord(u"hour")) {
+                failedLookups++;
+            }
+        }
+    });
+    for (int32_t count = 0; count < 3; count++) {
+        ::inflection::resources::DataRegistrationService::registerDictionaryForLocale(english, dictionaryDirectory + "mmappable_en.sdict");
+    }
+    done.store(true);
+    reader.join();
+    REQUIRE(failedLookups.load() == 0);
+    REQUIRE(dictionary == ::inflection::dictionary::DictionaryMetaData::createDictionary(english));
+
+    // The inflector uses the replacement, and the patterns and iterators that were obtained earlier keep the
+    // dictionary that they came from until they are deleted.
+    const auto& inflector = ::inflection::dictionary::Inflector::getInflector(english);
+    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> inflectionPatterns;
+    inflector.getInflectionPatternsForWord(u"hour", inflectionPatterns);
+    REQUIRE_FALSE(inflectionPatterns.empty());
+    const auto identifier(inflectionPatterns.front().getIdentifier());
+    auto knownWords(dictionary->getKnownWords());
+    ::inflection::resources::DataRegistrationService::registerDictionaryForLocale(english, dictionaryDirectory + "mmappable_en.sdict");
+    REQUIRE(&inflector == &::inflection::dictionary::Inflector::getInflector(english));
+    REQUIRE(identifier == inflectionPatterns.front().getIdentifier());
+    REQUIRE_FALSE((*knownWords.begin()).empty());
+    ::std::vector<::inflection::dictionary::Inflector_InflectionPattern> replacementPatterns;
+    inflector.getInflectionPatternsForWord(u"hour", replacementPatterns);
+    REQUIRE(identifier == replacementPatterns.front().getIdentifier());
+
+    // A bad replacement leaves the current dictionary in place.
+    CHECK_THROWS(::inflection::resources::DataRegistrationService::registerDictionaryForLocale(english, dictionaryDirectory + "mmappable_zz.sdict"));
+    CHECK_THROWS(::inflection::resources::DataRegistrationService::registerDictionaryForLocale(english, ::inflection::util::StringViewUtils::to_string(::inflection::util::ResourceLocator::getRootForLocale(::inflection::util::LocaleUtils::GERMAN())) + "/dictionary/mmappable_de.sdict"));
+    REQUIRE(dictionary->isKnownWord(u"hour"));
+}
+
+TEST_CASE("DataRegistrationServiceTest#testRegisterBundle")
+{
+    const auto& english = ::inflection::util::LocaleUtils::ENGLISH();
+    auto dictionary = npc(::inflection::dictionary::DictionaryMetaData::createDictionary(english));
+    auto dictionaryPath = ::inflection::util::ResourceLocator::getRootForLocale(english) + u"/dictionary/mmappable_en.sdict";
+    auto temporaryDirectory(createUniqueTemporaryDirectory("DataRegistrationServiceTest"));
+    auto bundlePath((temporaryDirectory / "DataRegistrationServiceTest.inbd").string());
+    // The files at the mount path do not exist. They are only in the bundle.
+    auto mountPath((temporaryDirectory / "mount").string());
+    // Other tests must not see the bundle, even when this one fails.
+    struct BundleCleanup {
+        const ::std::filesystem::path& temporaryDirectory;
+        const ::std::string& bundlePath;
+        ~BundleCleanup() {
+            ::inflection::resources::DataRegistrationService::unregisterBundle(bundlePath);
+            ::std::error_code errorCode;
+            ::std::filesystem::remove_all(temporaryDirectory, errorCode);
+        }
+    } bundleCleanup { temporaryDirectory, bundlePath };
+    auto bundledDictionaryPath(mountPath + "/dictionary/mmappable_en.sdict");
+    {
+        ::std::ofstream out(bundlePath, ::std::ios::binary);
+        ::inflection::util::ResourceBundle::write(out, {{"dictionary/mmappable_en.sdict", dictionaryPath}});
+    }
+    REQUIRE_FALSE(::inflection::util::AutoFileDescriptor::isAccessibleFile(::inflection::util::StringViewUtils::to_u16string(bundledDictionaryPath)));
+    CHECK_THROWS(::inflection::resources::DataRegistrationService::registerBundle(bundlePath + ".missing", mountPath));
+
+    ::inflection::resources::DataRegistrationService::registerBundle(bundlePath, mountPath);
+    ::std::filesystem::remove(bundlePath); // The mapping remains valid.
+    REQUIRE(::inflection::util::AutoFileDescriptor::isAccessibleFile(::inflection::util::StringViewUtils::to_u16string(bundledDictionaryPath)));
+    REQUIRE_FALSE(::inflection::util::AutoFileDescriptor::isAccessibleFile(::inflection::util::StringViewUtils::to_u16string(mountPath + "/dictionary/mmappable_zz.sdict")));
+
+    // The section is a complete dictionary.
+    ::inflection::resources::DataRegistrationService::registerDictionaryForLocale(english, bundledDictionaryPath);
+    REQUIRE(dictionary->isKnownWord(u"hour"));
+    ::inflection::resources::DataRegistrationService::registerDictionaryForLocale(english, ::inflection::util::StringViewUtils::to_string(dictionaryPath));
+    REQUIRE(dictionary->isKnownWord(u"hour"));
+
+    REQUIRE(::inflection::resources::DataRegistrationService::unregisterBundle(bundlePath));
+    REQUIRE_FALSE(::inflection::resources::DataRegistrationService::unregisterBundle(bundlePath));
+    REQUIRE_FALSE(::inflection::util::AutoFileDescriptor::isAccessibleFile(::inflection::util::StringViewUtils::to_u16string(bundledDictionaryPath)));
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include "catch2/catch_test_macros.hpp"
+
+#include <inflection/resources/MemoryBudget.hpp>
+#include <inflection/dictionary/DictionaryMetaData.hpp>
+#include <inflection/tokenizer/TokenChain.hpp>
+#include <inflection/tokenizer/Tokenizer.hpp>
+#include <inflection/tokenizer/TokenizerFactory.hpp>
+#include <inflection/util/LocaleUtils.hpp>
+#include <inflection/util/ULocale.hpp>
+#include <inflection/npc.hpp>
+#include <map>
+#include <memory>
+
+static constexpr char16_t TOKENIZER_INPUT[] = u"Hello world, 123 times!";
+
+static ::std::u16string tokenize(const ::inflection::tokenizer::Tokenizer& tokenizer)
+{
+    ::std::unique_ptr<::inflection::tokenizer::TokenChain> tokenChain(tokenizer.createTokenChain(TOKENIZER_INPUT));
+    return tokenChain->toString();
+}
+
+TEST_CASE("MemoryBudgetTest#testCycleSupportedLocales")
+{
+    auto locales(::inflection::util::LocaleUtils::getSupportedLocaleList());
+    ::std::map<::inflection::util::ULocale, int32_t> knownWordsSizes;
+    ::std::map<::inflection::util::ULocale, ::std::u16string> tokenizations;
+    // These outlive the evictions of their cached resources.
+    ::std::map<::inflection::util::ULocale, ::std::unique_ptr<::inflection::tokenizer::Tokenizer>> tokenizers;
+    for (const auto& locale : locales) {
+        knownWordsSizes.emplace(locale, npc(::inflection::dictionary::DictionaryMetaData::createDictionary(locale))->getKnownWordsSize());
+        auto& tokenizer = tokenizers[locale];
+        tokenizer.reset(::inflection::tokenizer::TokenizerFactory::createTokenizer(locale));
+        tokenizations.emplace(locale, tokenize(*tokenizer));
+    }
+    auto evictionCount = ::inflection::resources::MemoryBudget::getEvictionCount();
+    auto reloadCount = ::inflection::resources::MemoryBudget::getReloadCount();
+
+    // Only the language that was just loaded fits within this budget.
+    ::inflection::resources::MemoryBudget::setMemoryBudget(1);
+    REQUIRE(::inflection::resources::MemoryBudget::getMemoryBudget() == 1);
+    for (int32_t cycle = 0; cycle < 2; cycle++) {
+        for (const auto& locale : locales) {
+            INFO(locale.getName());
+            CHECK(npc(::inflection::dictionary::DictionaryMetaData::createDictionary(locale))->getKnownWordsSize() == knownWordsSizes[locale]);
+            ::std::unique_ptr<::inflection::tokenizer::Tokenizer> tokenizer(::inflection::tokenizer::TokenizerFactory::createTokenizer(locale));
+            CHECK(tokenize(*tokenizer) == tokenizations[locale]);
+            CHECK(tokenize(*tokenizers[locale]) == tokenizations[locale]);
+        }
+    }
+    ::inflection::resources::MemoryBudget::setMemoryBudget(0);
+
+    CHECK(::inflection::resources::MemoryBudget::getEvictionCount() > evictionCount);
+    CHECK(::inflection::resources::MemoryBudget::getReloadCount() > reloadCount);
+    CHECK_THROWS(::inflection::resources::MemoryBudget::setMemoryBudget(-1));
+    REQUIRE(::inflection::resources::MemoryBudget::getMemoryBudget() == 0);
+}
@@ -2,16 +2,19 @@
  * Copyright 2017-2026 Apple Inc. All rights reserved.
  */
 #include "Dictionary.hpp"
+#include "DictionaryBuildOptions.hpp"
 #include "DictionaryLogger.hpp"
 #include "LexicalDictionaryBuilder.hpp"
+#include <inflection/dictionary/metadata/KeyWeights.hpp>
 #include <inflection/lang/features/LanguageGrammarFeatures.hpp>
 #include <inflection/util/ULocale.hpp>
 #include <inflection/npc.hpp>
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 static const char USAGE_STRING[] =
-        "Usage: buildDictionary --locale LOCALE --outfile OUTFILE --infile INFILE [--supplementalfile INFILE] [--inflectionfile INFILE]";
+        "Usage: buildDictionary --locale LOCALE --outfile OUTFILE --infile INFILE [--supplementalfile INFILE] [--inflectionfile INFILE] [--utf8keys] [--casefoldedwords] [--materializepatternidentifiers] [--indexinflectiongrammemes] [--decodeinflectionsuffixes] [--membershipfilter] [--lemmaindex] [--keyweights INFILE]";
 
 static void checkArgument(bool failureCondition, std::string_view message) {
     if (failureCondition) {
@@ -29,6 +32,8 @@ int main(int argc, const char* const argv[])
     ::std::string additionalSourceFileName;
     ::std::string sourceInflectionFilename;
     bool verbose = false;
+    DictionaryBuildOptions options;
+    ::std::string keyWeightsFilename;
 
     for (int32_t i = 1; i < argc; i++) {
         if (std::string("--locale") == argv[i]) {
@@ -53,6 +58,24 @@ int main(int argc, const char* const argv[])
             sourceInflectionFilename = argv[++i];
         } else if (std::string("--verbose") == argv[i]) {
             verbose = true;
+        } else if (std::string("--utf8keys") == argv[i]) {
+            options.utf8Keys = true;
+        } else if (std::string("--casefoldedwords") == argv[i]) {
+            options.caseFoldedWords = true;
+        } else if (std::string("--materializepatternidentifiers") == argv[i]) {
+            options.materializePatternIdentifiers = true;
+        } else if (std::string("--indexinflectiongrammemes") == argv[i]) {
+            options.indexInflectionGrammemes = true;
+        } else if (std::string("--decodeinflectionsuffixes") == argv[i]) {
+            options.decodeInflectionSuffixes = true;
+        } else if (std::string("--membershipfilter") == argv[i]) {
+            options.membershipFilter = true;
+        } else if (std::string("--lemmaindex") == argv[i]) {
+            options.lemmaIndex = true;
+        } else if (std::string("--keyweights") == argv[i]) {
+            checkArgument(!keyWeightsFilename.empty(), "Multiple --keyweights parameters defined");
+            checkArgument(i + 1 >= argc, "Need a file path after --keyweights");
+            keyWeightsFilename = argv[++i];
         } else {
             checkArgument(true, std::string("Unknown argument: ") + argv[i]);
         }
@@ -61,6 +84,12 @@ int main(int argc, const char* const argv[])
     checkArgument(sourceFilename.empty(), "Required parameter --infile is missing");
     checkArgument(targetFilename.empty(), "Required parameter --outfile is missing");
 
+    ::std::unique_ptr<inflection::dictionary::metadata::KeyWeights> keyWeights;
+    if (!keyWeightsFilename.empty()) {
+        keyWeights.reset(new inflection::dictionary::metadata::KeyWeights(keyWeightsFilename));
+        options.keyWeights = keyWeights.get();
+    }
+
     auto dictionary = Dictionary::setupDictionary(locale, sourceFilename, additionalSourceFileName);
 
     for (const auto& grammarCategory : inflection::lang::features::LanguageGrammarFeatures::getLanguageGrammarFeatures(locale).getCategories()) {
@@ -78,7 +107,7 @@ int main(int argc, const char* const argv[])
         exit(-1);
     }
     DictionaryLogger logger(writer, verbose);
-    LexicalDictionaryBuilder::writeDictionary(writer, logger, *npc(dictionary), sourceInflectionFilename);
+    LexicalDictionaryBuilder::writeDictionary(writer, logger, *npc(dictionary), sourceInflectionFilename, options);
     logger.logWithOffset(locale.getName() + " final offset");
 
     delete dictionary;
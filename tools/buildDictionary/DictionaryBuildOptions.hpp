@@ -0,0 +1,49 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#pragma once
+
+#include <inflection/dictionary/metadata/fwd.hpp>
+
+/**
+ * The optional sections and layouts of a binary dictionary. Everything is off by default, which writes the smallest dictionary.
+ */
+struct DictionaryBuildOptions final
+{
+    /**
+     * When true, the words and the property values are stored as UTF-8 so that UTF-8 lookups need no conversion.
+     */
+    bool utf8Keys = false;
+    /**
+     * When true, the title case and uppercase forms of the lowercase words are added in an optional section,
+     * so that looking them up does not need a lowercase retry.
+     */
+    bool caseFoldedWords = false;
+    /**
+     * When true, the inflection pattern identifiers are decoded into a table when the dictionary is loaded.
+     */
+    bool materializePatternIdentifiers = false;
+    /**
+     * When true, the inflections of each inflection pattern are indexed by their grammemes
+     * the first time that an inflection with an exact set of grammemes is searched.
+     */
+    bool indexInflectionGrammemes = false;
+    /**
+     * When true, the inflection suffixes are decoded into a table when the dictionary is loaded.
+     */
+    bool decodeInflectionSuffixes = false;
+    /**
+     * When true, a filter of all of the words is added in an optional section, so that most
+     * words that are not in the dictionary are rejected without a trie lookup.
+     */
+    bool membershipFilter = false;
+    /**
+     * When true, and there is an inflection table, an index from each lemma to the words that
+     * inflect from it is added in an optional section.
+     */
+    bool lemmaIndex = false;
+    /**
+     * When not null, the word tries are laid out so that the words with a larger weight are faster to look up.
+     */
+    const inflection::dictionary::metadata::KeyWeights* keyWeights = nullptr;
+};
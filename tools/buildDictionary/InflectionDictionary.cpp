@@ -304,6 +304,18 @@ void InflectionDictionary::buildCompressedData(ParsedInflectionData& parsed)
     }
 
     identifierToInflectionPatternTrie = new inflection::dictionary::metadata::MarisaTrie<int32_t>(identifierToInflectionPatternMap);
+
+    // The suffixes are owned by the parsed data, so keep a copy for deriving lemmas later.
+    lemmaRules.resize(parsed.patterns.size());
+    for (const auto& pattern : parsed.patterns) {
+        auto& rule = lemmaRules.at(getId(pattern.identifier));
+        if (!pattern.lemmaSuffixes.empty()) {
+            rule.lemmaSuffix = pattern.lemmaSuffixes.front();
+        }
+        for (const auto& inflection : pattern.inflectionForGrammeme) {
+            rule.inflections.emplace_back(inflection.suffix, inflection.grammemes);
+        }
+    }
 }
 
 InflectionDictionary::~InflectionDictionary() {
@@ -316,16 +328,52 @@ int32_t InflectionDictionary::getId(std::u16string_view identifierStr) const
     return identifierToInflectionPatternTrie->getKeyId(identifierStr);
 }
 
+bool InflectionDictionary::getLemma(std::u16string* lemma, int32_t patternId, std::u16string_view word, int64_t wordGrammemes) const
+{
+    if (patternId < 0 || patternId >= int32_t(lemmaRules.size())) {
+        return false;
+    }
+    const auto& rule = lemmaRules[patternId];
+    if (rule.inflections.empty()) {
+        npc(lemma)->assign(word);
+        return true;
+    }
+    int32_t longestSuffixLength = -1;
+    for (const auto& [suffix, grammemes] : rule.inflections) {
+        if ((wordGrammemes & grammemes) == grammemes
+            && int32_t(suffix.length()) > longestSuffixLength
+            && word.ends_with(suffix))
+        {
+            longestSuffixLength = int32_t(suffix.length());
+        }
+    }
+    if (longestSuffixLength < 0) {
+        return false;
+    }
+    npc(lemma)->assign(word.substr(0, word.length() - longestSuffixLength));
+    lemma->append(rule.lemmaSuffix);
+    return true;
+}
+
 template<typename T>
 static void writeVal(::std::ofstream& writer, const T& value) {
     writer.write(reinterpret_cast<const char*>(&value), sizeof(value));
 }
 
-void InflectionDictionary::write(::std::ofstream& writer, DictionaryLogger& logger) const {
+void InflectionDictionary::write(::std::ofstream& writer, DictionaryLogger& logger, const DictionaryBuildOptions& buildOptions) const {
     writeVal(writer, inflection::dictionary::Inflector_MMappedDictionary::VERSION);
     writeVal(writer, inflection::dictionary::Inflector_MMappedDictionary::ENDIANNESS_MARKER);
-    // Write reserved options. It's currently unused.
-    writeVal(writer, inflection::dictionary::Inflector_MMappedDictionary::OPTIONS);
+    int16_t options = inflection::dictionary::Inflector_MMappedDictionary::OPTIONS;
+    if (buildOptions.materializePatternIdentifiers) {
+        options |= int16_t(inflection::dictionary::Inflector_MMappedDictionary::OptionBits::MATERIALIZE_PATTERN_IDENTIFIERS);
+    }
+    if (buildOptions.indexInflectionGrammemes) {
+        options |= int16_t(inflection::dictionary::Inflector_MMappedDictionary::OptionBits::INDEX_INFLECTION_GRAMMEMES);
+    }
+    if (buildOptions.decodeInflectionSuffixes) {
+        options |= int16_t(inflection::dictionary::Inflector_MMappedDictionary::OptionBits::DECODE_INFLECTION_SUFFIXES);
+    }
+    writeVal(writer, options);
 
     logger.logWithOffset(locale.getName() + " header");
 
@@ -3,6 +3,7 @@
  */
 #pragma once
 
+#include "DictionaryBuildOptions.hpp"
 #include "DictionaryLogger.hpp"
 #include "StringPool.hpp"
 #include "inflection/util/ULocale.hpp"
@@ -59,7 +60,14 @@ public:
     ~InflectionDictionary();
 
     int32_t getId(std::u16string_view identifierStr) const;
-    void write(::std::ofstream& writer, DictionaryLogger& logger) const;
+    /**
+     * Derive the lemma of a word that uses the inflection pattern with the given id. This mirrors
+     * Inflector_InflectionPattern::inflectionsForSurfaceForm: the longest inflection suffix whose grammemes are
+     * all on the word is removed, and the lemma suffix is appended to the remaining stem.
+     * @return false when no inflection of the pattern matches the word.
+     */
+    bool getLemma(std::u16string* lemma, int32_t patternId, std::u16string_view word, int64_t wordGrammemes) const;
+    void write(::std::ofstream& writer, DictionaryLogger& logger, const DictionaryBuildOptions& buildOptions) const;
 
 private:
     explicit InflectionDictionary(const ::inflection::util::ULocale &locale);
@@ -76,6 +84,11 @@ private:
     std::vector<int64_t> grammemePatterns {  };
     std::vector<int64_t> inflectionsArray {  };
     std::vector<int32_t> frequencyArray {  };
+    struct LemmaRule {
+        std::u16string lemmaSuffix {  };
+        std::vector<std::pair<std::u16string, int64_t>> inflections {  };
+    };
+    std::vector<LemmaRule> lemmaRules {  };
     int8_t numBitsForGrammemesIdx {  };
     int8_t numBitsForSuffixIdx {  };
 
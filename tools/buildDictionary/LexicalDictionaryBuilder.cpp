@@ -10,18 +10,22 @@
 #include <inflection/dictionary/metadata/CompressedArray.hpp>
 #include <inflection/dictionary/metadata/StringArrayContainer.hpp>
 #include <inflection/dictionary/metadata/MarisaTrie.hpp>
+#include <inflection/dictionary/metadata/MembershipFilter.hpp>
 #include <inflection/exception/IOException.hpp>
 #include <inflection/util/StringViewUtils.hpp>
 #include <inflection/npc.hpp>
 
 #include <string>
 #include <memory>
+#include <algorithm>
 #include <fstream>
 #include <ranges>
+#include <set>
 
 using inflection::dictionary::DictionaryMetaData_MMappedDictionary;
 using inflection::dictionary::metadata::CompressedArray;
 using inflection::dictionary::metadata::MarisaTrie;
+using inflection::dictionary::metadata::MembershipFilter;
 using inflection::dictionary::metadata::StringArrayContainer;
 using inflection::dictionary::metadata::StringContainer;
 
@@ -54,7 +58,10 @@ void LexicalDictionaryBuilder::write(::std::ofstream& writer,
                                      const inflection::dictionary::metadata::StringContainer& propertyValuesStringContainer,
                                      const inflection::dictionary::metadata::CompressedArray<int32_t>& propertyValueMaps,
                                      const inflection::dictionary::metadata::StringArrayContainer& typesStringContainer,
-                                     bool hasInflectionTable)
+                                     bool hasInflectionTable,
+                                     bool hasCaseFoldedWords,
+                                     bool hasMembershipFilter,
+                                     bool hasLemmaIndex)
 {
     writer.write(DictionaryMetaData_MMappedDictionary::MAGIC_MARKER, sizeof(DictionaryMetaData_MMappedDictionary::MAGIC_MARKER));
     writeVal(writer, DictionaryMetaData_MMappedDictionary::VERSION);
@@ -64,6 +71,15 @@ void LexicalDictionaryBuilder::write(::std::ofstream& writer,
     if (hasInflectionTable) {
         options |= int16_t(DictionaryMetaData_MMappedDictionary::OptionBits::HAS_INFLECTION_TABLE);
     }
+    if (hasCaseFoldedWords) {
+        options |= int16_t(DictionaryMetaData_MMappedDictionary::OptionBits::HAS_CASE_FOLDED_WORDS);
+    }
+    if (hasMembershipFilter) {
+        options |= int16_t(DictionaryMetaData_MMappedDictionary::OptionBits::HAS_MEMBERSHIP_FILTER);
+    }
+    if (hasLemmaIndex) {
+        options |= int16_t(DictionaryMetaData_MMappedDictionary::OptionBits::HAS_LEMMA_INDEX);
+    }
     writeVal(writer, options);
 
     const auto& language = locale.getLanguage();
@@ -149,7 +165,8 @@ createPropertyValueMap(
         std::map<::std::u16string_view, int32_t>& wordToPropertyValueMapIdMap,
         StringArrayContainer*& propertyNameToKeyId,
         StringContainer*& propertyValuesStringContainer,
-        std::vector<int32_t>& propertyValueMaps)
+        std::vector<int32_t>& propertyValueMaps,
+        bool utf8Keys)
 {
     ::std::map<::std::u16string_view, int32_t> keyContainerMap;
     ::std::map<::std::u16string_view, int32_t> valueContainerMap;
@@ -187,7 +204,7 @@ createPropertyValueMap(
     }
 
     propertyNameToKeyId = new StringArrayContainer(knownKeys, &keyContainerMap);
-    propertyValuesStringContainer = new StringContainer(knownValues, &valueContainerMap);
+    propertyValuesStringContainer = new StringContainer(knownValues, &valueContainerMap, utf8Keys);
     propertyValueMaps.reserve(expectedLength);
     propertyValueMaps.emplace_back(0); // Placeholder for invalid value.
     if (keyContainerMap.empty()) {
@@ -351,10 +368,41 @@ static CompressedDataSingletons compressDataSingletons(
     return result;
 }
 
+/**
+ * Map the title case and uppercase forms of each lowercase word to the data of the lowercase word.
+ * A form is only added when it is not a word itself, and when lowercasing it gives back the lowercase word.
+ * This makes the lookup of a form return the same result as looking it up, missing, and retrying with the lowercased form.
+ */
+static ::std::map<::std::u16string_view, uint64_t> createCaseFoldedWordsToData(const ::std::map<::std::u16string_view, uint64_t>& wordsToData, const ::inflection::util::ULocale& locale, ::std::set<::std::u16string>& caseFoldedWords)
+{
+    ::std::map<::std::u16string_view, uint64_t> result;
+    ::std::u16string lowercased;
+    ::std::u16string uppercased;
+    for (const auto& [word, data] : wordsToData) {
+        inflection::util::StringViewUtils::lowercase(&lowercased, word, locale);
+        if (lowercased != word) {
+            continue;
+        }
+        inflection::util::StringViewUtils::uppercase(&uppercased, word, locale);
+        for (const auto& caseForm : {inflection::util::StringViewUtils::capitalizeFirst(word, locale), uppercased}) {
+            if (caseForm == word || wordsToData.contains(caseForm)) {
+                continue;
+            }
+            inflection::util::StringViewUtils::lowercase(&lowercased, caseForm, locale);
+            if (lowercased != word) {
+                continue;
+            }
+            result.emplace(*caseFoldedWords.emplace(caseForm).first, data);
+        }
+    }
+    return result;
+}
+
 void LexicalDictionaryBuilder::writeDictionary(::std::ofstream& writer,
                                                DictionaryLogger& logger,
                                                const Dictionary &dictionary,
-                                               const ::std::string& sourceInflectionFilename)
+                                               const ::std::string& sourceInflectionFilename,
+                                               const DictionaryBuildOptions& options)
 {
     ::std::set<::std::u16string_view> typeStrings;
     for (auto name: dictionary.getValueToType() | std::views::values) {
@@ -399,7 +447,8 @@ void LexicalDictionaryBuilder::writeDictionary(::std::ofstream& writer,
                            wordToPropertyMapId,
                            propertyNameToKeyId,
                            propertyValuesStringContainer,
-                           propertyValueMapsVector);
+                           propertyValueMapsVector,
+                           options.utf8Keys);
     inflection::dictionary::metadata::CompressedArray<int32_t> propertyValueMaps(propertyValueMapsVector);
     propertyValueMapsVector.clear();
     propertyValueMapsVector.shrink_to_fit();
@@ -413,18 +462,80 @@ void LexicalDictionaryBuilder::writeDictionary(::std::ofstream& writer,
     for (const auto& [word, property] : wordToPropertyMapId) {
         writeBits(wordsToData[word], bitsTypesSingletons, bitsPropertyMapId, property);
     }
+    // The lemma of each word and inflection pattern is derived before the final word types are discarded.
+    bool lemmaIndex = options.lemmaIndex && inflectionDictionary != nullptr;
+    ::std::map<::std::u16string, ::std::vector<::std::pair<int32_t, ::std::u16string_view>>> lemmaToWords;
+    if (lemmaIndex) {
+        ::std::u16string lemma;
+        for (const auto& [word, properties] : dictionary.getWordToPropertyValue()) {
+            auto inflectionValues = properties.find(::inflection::dictionary::Inflector_MMappedDictionary::INFLECTION_KEY);
+            if (inflectionValues == properties.end()) {
+                continue;
+            }
+            auto typeSingleton = compressed.wordsToTypesSingletons.find(word);
+            int64_t wordGrammemes = typeSingleton == compressed.wordsToTypesSingletons.end() ? 0 : compressed.typeSingletons[typeSingleton->second];
+            for (const auto& identifier : inflectionValues->second) {
+                auto patternId = npc(inflectionDictionary)->getId(identifier);
+                if (inflectionDictionary->getLemma(&lemma, patternId, word, wordGrammemes)) {
+                    lemmaToWords[lemma].emplace_back(patternId, word);
+                }
+            }
+        }
+    }
     compressed.wordsToTypesSingletons.clear();
     wordToPropertyMapId.clear();
 
     // Compress the data structure
     auto dataSingletonsResult = compressDataSingletons(wordsToData, logger, dictionary.getLocale());
 
+    ::std::set<::std::u16string> caseFoldedWordsStrings;
+    ::std::unique_ptr<MarisaTrie<uint64_t>> caseFoldedWordsToDataTrie;
+    ::std::unique_ptr<MembershipFilter> wordsMembershipFilter;
+    ::std::unique_ptr<MarisaTrie<int32_t>> lemmaToWordsTrie;
+    ::std::unique_ptr<CompressedArray<int32_t>> lemmaToWordsEntries;
     {
         CompressedArray<uint64_t> dataSingletonsRaw(dataSingletonsResult.dataSingletons);
         dataSingletonsResult.dataSingletons.clear();
         dataSingletonsResult.dataSingletons.shrink_to_fit();
 
-        MarisaTrie<uint64_t> wordsToDataTrie(dataSingletonsResult.use2Stage ? dataSingletonsResult.wordsToDataSingletons : wordsToData);
+        const auto& wordsToDataTrieInput = dataSingletonsResult.use2Stage ? dataSingletonsResult.wordsToDataSingletons : wordsToData;
+        auto wordsToDataTrie = options.utf8Keys
+            ? MarisaTrie<uint64_t>(wordsToDataTrieInput, MarisaTrie<uint64_t>::UTF8, options.keyWeights)
+            : MarisaTrie<uint64_t>(wordsToDataTrieInput, options.keyWeights);
+        if (options.caseFoldedWords) {
+            auto caseFoldedWordsToData(createCaseFoldedWordsToData(wordsToDataTrieInput, dictionary.getLocale(), caseFoldedWordsStrings));
+            caseFoldedWordsToDataTrie.reset(options.utf8Keys
+                ? new MarisaTrie<uint64_t>(caseFoldedWordsToData, MarisaTrie<uint64_t>::UTF8, options.keyWeights)
+                : new MarisaTrie<uint64_t>(caseFoldedWordsToData, options.keyWeights));
+        }
+        if (options.membershipFilter) {
+            ::std::set<::std::u16string_view> allWords;
+            for (const auto& word : wordsToDataTrieInput | std::views::keys) {
+                allWords.insert(word);
+            }
+            allWords.insert(caseFoldedWordsStrings.begin(), caseFoldedWordsStrings.end());
+            wordsMembershipFilter.reset(new MembershipFilter(allWords));
+        }
+        if (lemmaIndex) {
+            // Each lemma points to a count followed by pairs of an inflection pattern id and a word id in wordsToDataTrie.
+            ::std::map<::std::u16string_view, int32_t> lemmaToOffset;
+            ::std::vector<int32_t> entries;
+            for (auto& [lemma, words] : lemmaToWords) {
+                ::std::stable_sort(words.begin(), words.end(), [](const auto& a, const auto& b) {
+                    return a.first < b.first;
+                });
+                lemmaToOffset.emplace(lemma, int32_t(entries.size()));
+                entries.emplace_back(int32_t(words.size()));
+                for (const auto& [patternId, word] : words) {
+                    entries.emplace_back(patternId);
+                    entries.emplace_back(wordsToDataTrie.getKeyId(word));
+                }
+            }
+            lemmaToWordsTrie.reset(options.utf8Keys
+                ? new MarisaTrie<int32_t>(lemmaToOffset, MarisaTrie<int32_t>::UTF8)
+                : new MarisaTrie<int32_t>(lemmaToOffset));
+            lemmaToWordsEntries.reset(new CompressedArray<int32_t>(entries));
+        }
         dataSingletonsResult.wordsToDataSingletons.clear();
         wordsToData.clear();
 
@@ -442,14 +553,34 @@ void LexicalDictionaryBuilder::writeDictionary(::std::ofstream& writer,
               *npc(propertyValuesStringContainer),
               propertyValueMaps,
               stringContainer,
-              hasInflectionTable);
+              hasInflectionTable,
+              options.caseFoldedWords,
+              options.membershipFilter,
+              lemmaIndex);
 
         delete propertyNameToKeyId;
         delete propertyValuesStringContainer;
     }
 
     if (inflectionDictionary != nullptr) {
-        inflectionDictionary->write(writer, logger);
+        inflectionDictionary->write(writer, logger, options);
         delete inflectionDictionary;
     }
+
+    if (caseFoldedWordsToDataTrie) {
+        // This optional section is last, so that it's read after the inflection table.
+        caseFoldedWordsToDataTrie->write(writer);
+        logger.logWithOffset(dictionary.getLocale().getName() + " caseFoldedWordsToDataTrie");
+    }
+    if (wordsMembershipFilter) {
+        // This optional section follows the case folded words, which are also in the filter.
+        wordsMembershipFilter->write(writer);
+        logger.logWithOffset(dictionary.getLocale().getName() + " wordsMembershipFilter");
+    }
+    if (lemmaToWordsTrie) {
+        lemmaToWordsTrie->write(writer);
+        logger.logWithOffset(dictionary.getLocale().getName() + " lemmaToWordsTrie");
+        lemmaToWordsEntries->serialize(writer);
+        logger.logWithOffset(dictionary.getLocale().getName() + " lemmaToWordsEntries");
+    }
 }
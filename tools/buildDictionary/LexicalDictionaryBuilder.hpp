@@ -5,6 +5,7 @@
 
 #include <inflection/dictionary/metadata/fwd.hpp>
 #include "Dictionary.hpp"
+#include "DictionaryBuildOptions.hpp"
 #include "DictionaryLogger.hpp"
 #include <cstdint>
 #include <map>
@@ -14,7 +15,10 @@
 class LexicalDictionaryBuilder final
 {
 public:
-    static void writeDictionary(::std::ofstream& writer, DictionaryLogger& logger, const Dictionary& dictionary, const ::std::string& sourceInflectionFilename);
+    /**
+     * @param options The optional sections and layouts of the dictionary.
+     */
+    static void writeDictionary(::std::ofstream& writer, DictionaryLogger& logger, const Dictionary& dictionary, const ::std::string& sourceInflectionFilename, const DictionaryBuildOptions& options);
 
     template <typename T1, typename T2>
     static int8_t getNumBitsFromValues(const ::std::map<T1, T2> &wordToData);
@@ -36,7 +40,10 @@ private:
                       const inflection::dictionary::metadata::StringContainer& propertyValuesStringContainer,
                       const inflection::dictionary::metadata::CompressedArray<int32_t>& propertyValueMaps,
                       const inflection::dictionary::metadata::StringArrayContainer& typesStringContainer,
-                      bool hasInflectionTable);
+                      bool hasInflectionTable,
+                      bool hasCaseFoldedWords,
+                      bool hasMembershipFilter,
+                      bool hasLemmaIndex);
 
     template <typename T>
     static void writeBits(uint64_t &valueBase, int32_t start, int32_t len, T valueToWrite);
@@ -0,0 +1,91 @@
+/*
+ * Copyright 2025 Unicode Incorporated and others. All rights reserved.
+ */
+#include <inflection/util/ResourceBundle.hpp>
+#include <inflection/util/StringViewUtils.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+static constexpr char USAGE_STRING[] =
+    "Usage: buildResourceBundle --root DIRECTORY --outfile OUTFILE FILE...\n"
+    "Each FILE must be inside DIRECTORY. When FILE is a directory, all of the files in it are added.\n"
+    "Register the bundle with DataRegistrationService::registerBundle using DIRECTORY as the mount path.";
+
+static bool addFile(::std::map<::std::string, ::std::u16string>* sections, const ::std::filesystem::path& root, const ::std::filesystem::path& file)
+{
+    auto relativePath(::std::filesystem::weakly_canonical(file).lexically_relative(root));
+    auto relativeName(relativePath.generic_u8string());
+    if (relativePath.empty() || relativeName.starts_with(u8"..")) {
+        std::cerr << "The file " << file.string() << " is not inside " << root.string() << std::endl;
+        return false;
+    }
+    auto name(::std::string(reinterpret_cast<const char*>(relativeName.data()), relativeName.length()));
+    auto fullPath(::std::filesystem::weakly_canonical(file).u16string());
+    sections->emplace(name, ::std::u16string(reinterpret_cast<const char16_t*>(fullPath.data()), fullPath.length()));
+    return true;
+}
+
+int main(int argc, const char * const argv[]) {
+    ::std::filesystem::path root;
+    const char* outFileName = nullptr;
+    ::std::vector<::std::filesystem::path> files;
+    for (int i = 1; i < argc; i++) {
+        ::std::string_view arg(argv[i]);
+        if (arg == "--root" && i + 1 < argc) {
+            root = ::std::filesystem::weakly_canonical(argv[++i]);
+        }
+        else if (arg == "--outfile" && i + 1 < argc) {
+            outFileName = argv[++i];
+        }
+        else if (arg.starts_with("--")) {
+            std::cout << USAGE_STRING << std::endl;
+            return -1;
+        }
+        else {
+            files.emplace_back(arg);
+        }
+    }
+    if (root.empty() || outFileName == nullptr || files.empty()) {
+        std::cout << USAGE_STRING << std::endl;
+        return -1;
+    }
+
+    ::std::map<::std::string, ::std::u16string> sections;
+    int32_t errorCount = 0;
+    for (const auto& file : files) {
+        if (::std::filesystem::is_directory(file)) {
+            for (const auto& entry : ::std::filesystem::recursive_directory_iterator(file)) {
+                if (entry.is_regular_file() && !addFile(&sections, root, entry.path())) {
+                    errorCount++;
+                }
+            }
+        }
+        else if (!::std::filesystem::is_regular_file(file)) {
+            std::cerr << "The file " << file.string() << " does not exist" << std::endl;
+            errorCount++;
+        }
+        else if (!addFile(&sections, root, file)) {
+            errorCount++;
+        }
+    }
+    if (errorCount > 0) {
+        std::cerr << errorCount << " Errors" << std::endl;
+        return -1;
+    }
+
+    std::ofstream out(outFileName, std::ios::binary);
+    if (!out) {
+        std::cerr << "Unable to open output file: " << outFileName << std::endl;
+        return -1;
+    }
+    try {
+        ::inflection::util::ResourceBundle::write(out, sections);
+    }
+    catch (const ::std::exception& e) {
+        std::cerr << "Unable to write the bundle: " << e.what() << std::endl;
+        return -1;
+    }
+    return 0;
+}
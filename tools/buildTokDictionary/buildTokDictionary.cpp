@@ -1,6 +1,7 @@
 /*
  * Copyright 2018-2024 Apple Inc. All rights reserved.
  */
+#include <inflection/dictionary/metadata/KeyWeights.hpp>
 #include <inflection/dictionary/metadata/MarisaTrie.hpp>
 #include <inflection/tokenizer/trie/SerializedTrie.hpp>
 #include <inflection/util/StringUtils.hpp>
@@ -8,6 +9,7 @@
 #include <unicode/ustring.h>
 #include <iostream>
 #include <fstream>
+#include <memory>
 
 static std::u16string_view trimWhitespace(std::u16string_view str) {
     int32_t len = int32_t(str.length());
@@ -80,7 +82,7 @@ char16_t *strdup(std::u16string_view str) {
 static constexpr int32_t INITIAL_STRING_SINGLETON_SIZE = 256*1024;
 static constexpr int16_t ENDIANNESS_MARKER = 1;
 static constexpr char USAGE_STRING[] =
-    "Usage: buildTokDictionary INFILE OUTFILE";
+    "Usage: buildTokDictionary INFILE OUTFILE [--keyweights INFILE]";
 
 int main(int argc, const char * const argv[]) {
     // If no command line arguments, print usage and exit
@@ -90,6 +92,14 @@ int main(int argc, const char * const argv[]) {
 
     std::string inFileName(argv[1]);
     std::string outFileName(argv[2]);
+    ::std::unique_ptr<::inflection::dictionary::metadata::KeyWeights> keyWeights;
+    if (argc == 5 && std::string("--keyweights") == argv[3]) {
+        keyWeights.reset(new ::inflection::dictionary::metadata::KeyWeights(argv[4]));
+    }
+    else if (argc != 3) {
+        std::cerr << USAGE_STRING << std::endl;
+        return -1;
+    }
     std::ifstream in(inFileName);
     if (!in) {
         std::cerr << "Unable to open input file: " << inFileName << std::endl;
@@ -143,7 +153,7 @@ int main(int argc, const char * const argv[]) {
     }
 
     if (errorCount == 0) {
-        ::inflection::dictionary::metadata::MarisaTrie<int32_t> trie(stringToIntegerMap);
+        ::inflection::dictionary::metadata::MarisaTrie<int32_t> trie(stringToIntegerMap, keyWeights.get());
         out.write(inflection::tokenizer::trie::SerializedTrie::MAGIC_MARKER, sizeof(inflection::tokenizer::trie::SerializedTrie::MAGIC_MARKER));
         out.write(reinterpret_cast<const char*>(&inflection::tokenizer::trie::SerializedTrie::VERSION), sizeof(inflection::tokenizer::trie::SerializedTrie::VERSION));
         out.write(reinterpret_cast<const char*>(&ENDIANNESS_MARKER), sizeof(ENDIANNESS_MARKER));